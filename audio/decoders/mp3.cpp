@@ -308,15 +308,27 @@ int BaseMP3Stream::fillBuffer(Common::ReadStream &stream, int16 *buffer, const i
 	int samples = 0;
 	// Keep going as long as we have input available
 	while (samples < numSamples && _state != MP3_STATE_EOS) {
-		const int len = MIN(numSamples, samples + (int)(_synth.pcm.length - _posInFrame) * MAD_NCHANNELS(&_frame.header));
-		while (samples < len) {
-			*buffer++ = (int16)scaleSample(_synth.pcm.samples[0][_posInFrame]);
-			samples++;
-			if (MAD_NCHANNELS(&_frame.header) == 2) {
-				*buffer++ = (int16)scaleSample(_synth.pcm.samples[1][_posInFrame]);
-				samples++;
+		const int channels = MAD_NCHANNELS(&_frame.header);
+		const int len = MIN(numSamples, samples + (int)(_synth.pcm.length - _posInFrame) * channels);
+
+		// Convert whole sample frames with the channel count hoisted out of
+		// the loop, so the compiler can keep both loops branch free
+		const mad_fixed_t *left = &_synth.pcm.samples[0][_posInFrame];
+		if (channels == 2) {
+			const mad_fixed_t *right = &_synth.pcm.samples[1][_posInFrame];
+			const int frames = (len - samples + 1) / 2;
+			for (int i = 0; i < frames; i++) {
+				*buffer++ = (int16)scaleSample(left[i]);
+				*buffer++ = (int16)scaleSample(right[i]);
 			}
-			_posInFrame++;
+			samples += frames * 2;
+			_posInFrame += frames;
+		} else {
+			const int frames = len - samples;
+			for (int i = 0; i < frames; i++)
+				*buffer++ = (int16)scaleSample(left[i]);
+			samples += frames;
+			_posInFrame += frames;
 		}
 		if (_posInFrame >= _synth.pcm.length) {
 			// We used up all PCM data in the current frame -- read & decode more
@@ -118,6 +118,7 @@ public:
 	Timestamp getLength() const { return _length; }
 protected:
 	bool refill();
+	long decode(char *dst, uint size);
 };
 
 VorbisStream::VorbisStream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag dispose) :
@@ -160,6 +161,18 @@ int VorbisStream::readBuffer(int16 *buffer, const int numSamples) {
 		_pos += len;
 		samples += len;
 		if (_pos >= _bufferEnd) {
+			// Decode whole buffers worth of data straight into the caller's
+			// buffer, our own buffer only keeps the remainder and is used to
+			// detect the end of the stream
+			const int directSamples = (numSamples - samples) - (numSamples - samples) % (int)ARRAYSIZE(_buffer);
+			if (directSamples > 0) {
+				const long result = decode((char *)buffer, directSamples * 2);
+				if (result < 0)
+					break;
+				buffer += result / 2;
+				samples += result / 2;
+			}
+
 			if (!refill())
 				break;
 		}
@@ -181,9 +194,24 @@ bool VorbisStream::seek(const Timestamp &where) {
 }
 
 bool VorbisStream::refill() {
+	const long result = decode((char *)_buffer, sizeof(_buffer));
+	if (result < 0) {
+		_pos = _bufferEnd;
+		// Don't delete it yet, that causes problems in
+		// the CD player emulation code.
+		return false;
+	}
+
+	_pos = _buffer;
+	_bufferEnd = _buffer + result / 2;
+
+	return true;
+}
+
+long VorbisStream::decode(char *dst, uint size) {
 	// Read the samples
-	uint len_left = sizeof(_buffer);
-	char *read_pos = (char *)_buffer;
+	uint len_left = size;
+	char *read_pos = dst;
 
 	while (len_left > 0) {
 		long result;
@@ -214,25 +242,17 @@ bool VorbisStream::refill() {
 			warning("Corrupted data in Vorbis file");
 		} else if (result == 0) {
 			//warning("End of file while reading from Vorbis file");
-			//_pos = _bufferEnd;
-			//return false;
 			break;
 		} else if (result < 0) {
 			warning("Error reading from Vorbis stream (%d)", int(result));
-			_pos = _bufferEnd;
-			// Don't delete it yet, that causes problems in
-			// the CD player emulation code.
-			return false;
+			return -1;
 		} else {
 			len_left -= result;
 			read_pos += result;
 		}
 	}
 
-	_pos = _buffer;
-	_bufferEnd = (int16 *)read_pos;
-
-	return true;
+	return read_pos - dst;
 }
 
 
@@ -86,6 +86,9 @@ public:
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual uint32 getMillis(bool skipRecord = false);
+#ifdef POSIX
+	virtual uint64 getMicros();
+#endif
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &t) const;
 
@@ -200,6 +203,17 @@ uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #endif
 }
 
+#ifdef POSIX
+// Other targets use the getMillis() based fallback of OSystem
+uint64 OSystem_NULL::getMicros() {
+	timeval curTime;
+
+	gettimeofday(&curTime, 0);
+
+	return (uint64)(curTime.tv_sec - _startTime.tv_sec) * 1000000 + (curTime.tv_usec - _startTime.tv_usec);
+}
+#endif
+
 void OSystem_NULL::delayMillis(uint msecs) {
 #ifdef POSIX
 	usleep(msecs * 1000);
@@ -624,6 +624,16 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+uint64 OSystem_SDL::getMicros() {
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+
+	// Split the conversion to avoid overflowing with high frequency counters
+	return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+}
+#endif
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
@@ -33,6 +33,7 @@
 #include "common/macresman.h"
 #include "common/memstream.h"
 #include "common/quicktime.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 #include "common/zlib.h"
@@ -50,6 +51,9 @@ QuickTimeParser::QuickTimeParser() {
 	_scaleFactorY = 1;
 	_resFork = new MacResManager();
 	_disposeFileHandle = DisposeAfterUse::YES;
+	_pagedSampleTables = true;
+	_canPageSampleTables = false;
+	_parseTime = 0;
 
 	initParseTable();
 }
@@ -63,6 +67,8 @@ bool QuickTimeParser::parseFile(const String &filename) {
 	if (!_resFork->open(filename) || !_resFork->hasDataFork())
 		return false;
 
+	uint32 startTime = g_system->getMillis();
+
 	_foundMOOV = false;
 	_disposeFileHandle = DisposeAfterUse::YES;
 
@@ -76,6 +82,8 @@ bool QuickTimeParser::parseFile(const String &filename) {
 			_fd = _resFork->getResource(MKTAG('m', 'o', 'o', 'v'), idArray[0]);
 
 		if (_fd) {
+			// The resource stream is discarded after parsing, so tables must be loaded
+			_canPageSampleTables = false;
 			atom.size = _fd->size();
 			if (readDefault(atom) < 0 || !_foundMOOV)
 				return false;
@@ -85,19 +93,26 @@ bool QuickTimeParser::parseFile(const String &filename) {
 	}
 
 	_fd = _resFork->getDataFork();
+	_canPageSampleTables = true;
 	atom.size = _fd->size();
 
 	if (readDefault(atom) < 0 || !_foundMOOV)
 		return false;
 
 	init();
+
+	_parseTime = g_system->getMillis() - startTime;
+	debug(1, "QuickTimeParser: Parsed '%s' in %d ms", filename.c_str(), _parseTime);
 	return true;
 }
 
 bool QuickTimeParser::parseStream(SeekableReadStream *stream, DisposeAfterUse::Flag disposeFileHandle) {
+	uint32 startTime = g_system->getMillis();
+
 	_fd = stream;
 	_foundMOOV = false;
 	_disposeFileHandle = disposeFileHandle;
+	_canPageSampleTables = true;
 
 	Atom atom = { 0, 0, 0xffffffff };
 
@@ -107,6 +122,9 @@ bool QuickTimeParser::parseStream(SeekableReadStream *stream, DisposeAfterUse::F
 	}
 
 	init();
+
+	_parseTime = g_system->getMillis() - startTime;
+	debug(1, "QuickTimeParser: Parsed stream in %d ms", _parseTime);
 	return true;
 }
 
@@ -297,7 +315,9 @@ int QuickTimeParser::readCMOV(Atom atom) {
 
 	// Load data into a new MemoryReadStream and assign _fd to be that
 	SeekableReadStream *oldStream = _fd;
+	bool oldCanPage = _canPageSampleTables;
 	_fd = new MemoryReadStream(uncompressedData, uncompressedSize, DisposeAfterUse::YES);
+	_canPageSampleTables = false;
 
 	// Read the contents of the uncompressed data
 	Atom a = { MKTAG('m', 'o', 'o', 'v'), 0, uncompressedSize };
@@ -307,6 +327,7 @@ int QuickTimeParser::readCMOV(Atom atom) {
 	free(compressedData);
 	delete _fd;
 	_fd = oldStream;
+	_canPageSampleTables = oldCanPage;
 
 	return err;
 #else
@@ -622,16 +643,9 @@ int QuickTimeParser::readSTSZ(Atom atom) {
 	if (track->sampleSize)
 		return 0; // there isn't any table following
 
-	track->sampleSizes = new uint32[track->sampleCount];
-
-	if (!track->sampleSizes)
+	if (!track->sampleSizes.load(_fd, track->sampleCount, 0, _pagedSampleTables && _canPageSampleTables))
 		return -1;
 
-	for(uint32 i = 0; i < track->sampleCount; i++) {
-		track->sampleSizes[i] = _fd->readUint32BE();
-		debug(6, "sampleSizes[%d] = %d", i, track->sampleSizes[i]);
-	}
-
 	return 0;
 }
 
@@ -667,18 +681,13 @@ int QuickTimeParser::readSTCO(Atom atom) {
 	_fd->readByte(); _fd->readByte(); _fd->readByte(); // flags
 
 	track->chunkCount = _fd->readUint32BE();
-	track->chunkOffsets = new uint32[track->chunkCount];
 
-	if (!track->chunkOffsets)
+	// WORKAROUND/HACK: The offsets in Riven videos (ones inside the Mohawk archives themselves)
+	// have offsets relative to the archive and not the video. This is quite nasty. We subtract
+	// the initial offset of the stream to get the correct value inside of the stream.
+	if (!track->chunkOffsets.load(_fd, track->chunkCount, _beginOffset, _pagedSampleTables && _canPageSampleTables))
 		return -1;
 
-	for (uint32 i = 0; i < track->chunkCount; i++) {
-		// WORKAROUND/HACK: The offsets in Riven videos (ones inside the Mohawk archives themselves)
-		// have offsets relative to the archive and not the video. This is quite nasty. We subtract
-		// the initial offset of the stream to get the correct value inside of the stream.
-		track->chunkOffsets[i] = _fd->readUint32BE() - _beginOffset;
-	}
-
 	return 0;
 }
 
@@ -819,16 +828,83 @@ QuickTimeParser::SampleDesc::~SampleDesc() {
 	delete _extraData;
 }
 
+QuickTimeParser::SampleTable::SampleTable() {
+	_count = 0;
+	_bias = 0;
+	_entries = nullptr;
+	_stream = nullptr;
+	_tableOffset = 0;
+	_pageStart = 0;
+	_page = nullptr;
+}
+
+QuickTimeParser::SampleTable::~SampleTable() {
+	clear();
+}
+
+void QuickTimeParser::SampleTable::clear() {
+	delete[] _entries;
+	delete[] _page;
+	_entries = nullptr;
+	_page = nullptr;
+	_stream = nullptr;
+	_count = 0;
+}
+
+bool QuickTimeParser::SampleTable::load(SeekableReadStream *stream, uint32 count, uint32 bias, bool paged) {
+	clear();
+
+	_count = count;
+	_bias = bias;
+
+	// Small tables are not worth paging
+	if (paged && count > kPageSize) {
+		_stream = stream;
+		_tableOffset = stream->pos();
+
+		if (!stream->skip(count * 4))
+			return false;
+
+		// No page is loaded yet, any valid index is out of the current page
+		_pageStart = count;
+		_page = new uint32[kPageSize];
+
+		debug(5, "SampleTable: %d entries at offset %d are paged", count, _tableOffset);
+		return true;
+	}
+
+	_entries = new uint32[count];
+
+	for (uint32 i = 0; i < count; i++) {
+		_entries[i] = stream->readUint32BE() - bias;
+		debug(6, "entries[%d] = %d", i, _entries[i]);
+	}
+
+	return !stream->err();
+}
+
+void QuickTimeParser::SampleTable::loadPage(uint32 index) const {
+	// The stream is shared with the sample data readers: preserve its position
+	int32 oldPos = _stream->pos();
+
+	_pageStart = index - (index % kPageSize);
+	uint32 pageEntries = MIN<uint32>(kPageSize, _count - _pageStart);
+
+	_stream->seek(_tableOffset + _pageStart * 4);
+	for (uint32 i = 0; i < pageEntries; i++)
+		_page[i] = _stream->readUint32BE() - _bias;
+
+	_stream->seek(oldPos);
+}
+
 QuickTimeParser::Track::Track() {
 	chunkCount = 0;
-	chunkOffsets = nullptr;
 	timeToSampleCount = 0;
 	timeToSample = nullptr;
 	sampleToChunkCount = 0;
 	sampleToChunk = nullptr;
 	sampleSize = 0;
 	sampleCount = 0;
-	sampleSizes = nullptr;
 	keyframeCount = 0;
 	keyframes = nullptr;
 	timeScale = 0;
@@ -842,10 +918,8 @@ QuickTimeParser::Track::Track() {
 }
 
 QuickTimeParser::Track::~Track() {
-	delete[] chunkOffsets;
 	delete[] timeToSample;
 	delete[] sampleToChunk;
-	delete[] sampleSizes;
 	delete[] keyframes;
 
 	for (uint32 i = 0; i < sampleDescs.size(); i++)
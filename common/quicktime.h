@@ -86,6 +86,21 @@ public:
 	/** Find out if this parser has an open file handle */
 	bool isOpen() const { return _fd != nullptr; }
 
+	/**
+	 * Enable or disable paged sample tables (enabled by default).
+	 *
+	 * When enabled, large sample size (stsz) and chunk offset (stco) tables
+	 * are not loaded when the file is opened, but read from the file one
+	 * page at a time when accessed. This keeps the memory usage of large
+	 * movies low and reduces the time needed to open them.
+	 *
+	 * Must be called before the file is parsed.
+	 */
+	void setPagedSampleTables(bool paged) { _pagedSampleTables = paged; }
+
+	/** Return the time it took to parse the file, in milliseconds */
+	uint32 getParseTime() const { return _parseTime; }
+
 protected:
 	// This is the file handle from which data is read from. It can be the actual file handle or a decompressed stream.
 	SeekableReadStream *_fd;
@@ -108,6 +123,56 @@ protected:
 		Rational mediaRate;
 	};
 
+	/**
+	 * A table of 32-bit big endian values (sample sizes, chunk offsets)
+	 * which is either fully loaded or read from the file on demand.
+	 */
+	class SampleTable {
+	public:
+		SampleTable();
+		~SampleTable();
+
+		/**
+		 * Load a table of count entries starting at the current position of the stream.
+		 * Each entry is decremented by bias.
+		 * If paged is set, only the location of the table is stored and the stream
+		 * must stay valid for the lifetime of the table.
+		 */
+		bool load(SeekableReadStream *stream, uint32 count, uint32 bias, bool paged);
+		void clear();
+
+		uint32 size() const { return _count; }
+		bool empty() const { return _count == 0; }
+
+		uint32 operator[](uint32 index) const {
+			assert(index < _count);
+			if (_entries)
+				return _entries[index];
+
+			if (index - _pageStart >= kPageSize)
+				loadPage(index);
+
+			return _page[index - _pageStart];
+		}
+
+	private:
+		enum {
+			kPageSize = 1024
+		};
+
+		void loadPage(uint32 index) const;
+
+		uint32 _count;
+		uint32 _bias;
+		uint32 *_entries;
+
+		// Paged mode
+		SeekableReadStream *_stream;
+		int32 _tableOffset;
+		mutable uint32 _pageStart;
+		mutable uint32 *_page;
+	};
+
 	struct Track;
 
 	class SampleDesc {
@@ -137,14 +202,14 @@ protected:
 		~Track();
 
 		uint32 chunkCount;
-		uint32 *chunkOffsets;
+		SampleTable chunkOffsets;
 		int timeToSampleCount;
 		TimeToSampleEntry *timeToSample;
 		uint32 sampleToChunkCount;
 		SampleToChunkEntry *sampleToChunk;
 		uint32 sampleSize;
 		uint32 sampleCount;
-		uint32 *sampleSizes;
+		SampleTable sampleSizes;
 		uint32 keyframeCount;
 		uint32 *keyframes;
 		int32 timeScale;
@@ -192,6 +257,9 @@ private:
 	uint32 _beginOffset;
 	MacResManager *_resFork;
 	bool _foundMOOV;
+	bool _pagedSampleTables;
+	bool _canPageSampleTables; ///< Whether _fd stays open after parsing
+	uint32 _parseTime;
 
 	void initParseTable();
 
@@ -1298,6 +1298,18 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/** Get the number of microseconds since an arbitrary point in time.
+	 *
+	 * Only differences between two values are meaningful. This is meant
+	 * for measuring short durations, such as profiling statistics, and is
+	 * never recorded by the event recorder.
+	 *
+	 * The default implementation returns getMillis() in microseconds, so
+	 * backends without a finer clock, or on which it is not implemented,
+	 * still return a valid (if coarse) value.
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -21,6 +21,7 @@
  */
 
 #include "common/endian.h"
+#include "common/system.h"
 
 #include "graphics/colormasks.h"
 #include "graphics/pixelbuffer.h"
@@ -90,6 +91,7 @@ void BitmapData::load() {
 	if (_loaded) {
 		return;
 	}
+	uint32 startTime = g_system->getMillis();
 	Common::SeekableReadStream *data = g_resourceloader->openNewStreamFile(_fname.c_str());
 
 	uint32 tag = data->readUint32BE();
@@ -107,6 +109,7 @@ void BitmapData::load() {
 	}
 	delete data;
 	_loaded = true;
+	g_resourceloader->logLoadTime(ResourceLoader::kResourceBitmap, _fname, startTime);
 }
 
 bool BitmapData::loadGrimBm(Common::SeekableReadStream *data) {
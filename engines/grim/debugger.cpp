@@ -26,6 +26,9 @@
 #include "engines/grim/debugger.h"
 #include "engines/grim/md5check.h"
 #include "engines/grim/grim.h"
+#include "engines/grim/gfx_base.h"
+#include "engines/grim/resource.h"
+#include "engines/grim/lua/lua.h"
 
 namespace Grim {
 
@@ -38,6 +41,9 @@ Debugger::Debugger() :
 	registerCmd("set_renderer", WRAP_METHOD(Debugger, cmd_set_renderer));
 	registerCmd("save", WRAP_METHOD(Debugger, cmd_save));
 	registerCmd("load", WRAP_METHOD(Debugger, cmd_load));
+	registerCmd("draw_calls", WRAP_METHOD(Debugger, cmd_draw_calls));
+	registerCmd("resource_stats", WRAP_METHOD(Debugger, cmd_resource_stats));
+	registerCmd("lua_gc", WRAP_METHOD(Debugger, cmd_lua_gc));
 }
 
 Debugger::~Debugger() {
@@ -127,4 +133,41 @@ bool Debugger::cmd_load(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmd_draw_calls(int argc, const char **argv) {
+	debugPrintf("Draw calls in the last frame: %u\n", g_driver->getLastFrameDrawCalls());
+	return true;
+}
+
+bool Debugger::cmd_resource_stats(int argc, const char **argv) {
+	debugPrintf("%-10s %6s %8s %6s\n", "Type", "Count", "Total ms", "Max ms");
+	for (int i = 0; i < ResourceLoader::kResourceTypeCount; ++i) {
+		ResourceLoader::ResourceType type = (ResourceLoader::ResourceType)i;
+		const ResourceLoader::LoadStats &stats = g_resourceloader->getLoadStats(type);
+		debugPrintf("%-10s %6u %8u %6u\n", ResourceLoader::getResourceTypeName(type), stats.count, stats.totalTime, stats.maxTime);
+	}
+	debugPrintf("Prefetch: %u hits, %u misses, %u bytes waiting\n", g_resourceloader->getPrefetchHits(),
+				g_resourceloader->getPrefetchMisses(), g_resourceloader->getPrefetchMemorySize());
+	return true;
+}
+
+bool Debugger::cmd_lua_gc(int argc, const char **argv) {
+	if (argc > 1) {
+		if (!strcmp(argv[1], "full")) {
+			lua_setgcmode(LUA_GC_FULL);
+		} else if (!strcmp(argv[1], "incremental")) {
+			lua_setgcmode(LUA_GC_INCREMENTAL);
+		} else {
+			debugPrintf("Usage: lua_gc [full|incremental]\n");
+			return true;
+		}
+	}
+
+	lua_GCStats stats;
+	lua_getgcstats(&stats);
+	debugPrintf("Mode: %s\n", lua_getgcmode() == LUA_GC_INCREMENTAL ? "incremental" : "full");
+	debugPrintf("Cycles: %d, incremental steps: %d\n", stats.cycles, stats.steps);
+	debugPrintf("Pauses: last %u ms, max %u ms, total %u ms\n", stats.lastPause, stats.maxPause, stats.totalPause);
+	return true;
+}
+
 }
@@ -50,7 +50,8 @@ GfxBase::GfxBase() :
 		_currentPos(0, 0, 0), _dimLevel(0.0f),
 		_screenWidth(0), _screenHeight(0),
 		_scaleW(1.0f), _scaleH(1.0f), _currentShadowArray(nullptr),
-		_shadowColorR(255), _shadowColorG(255), _shadowColorB(255) {
+		_shadowColorR(255), _shadowColorG(255), _shadowColorB(255),
+		_drawCalls(0), _lastFrameDrawCalls(0) {
 			for (unsigned int i = 0; i < _numSpecialtyTextures; i++) {
 				_specialtyTextures[i]._isShared = true;
 			}
@@ -109,6 +110,11 @@ void GfxBase::drawMesh(const Mesh *mesh) {
 		mesh->_faces[i].draw(mesh);
 }
 
+void GfxBase::drawSprites(const Sprite *const *sprites, int count) {
+	for (int i = 0; i < count; i++)
+		drawSprite(sprites[i]);
+}
+
 #ifndef USE_OPENGL_GAME
 // Allow CreateGfxOpenGL to be called even if OpenGL isn't included
 GfxBase *CreateGfxOpenGL() {
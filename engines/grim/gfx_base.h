@@ -141,6 +141,11 @@ public:
 	virtual void drawEMIModelFace(const EMIModel *model, const EMIMeshFace *face) = 0;
 	virtual void drawModelFace(const Mesh *mesh, const MeshFace *face) = 0;
 	virtual void drawSprite(const Sprite *sprite) = 0;
+	/**
+	 * Draws sprites which share their material and flags, in order. The
+	 * material has already been selected.
+	 */
+	virtual void drawSprites(const Sprite *const *sprites, int count);
 	virtual void drawMesh(const Mesh *mesh);
 
 	virtual void drawOverlay(const Overlay *overlay) { };
@@ -274,8 +279,17 @@ public:
 	Texture *getSpecialtyTexturePtr(Common::String name);
 
 	virtual void setBlendMode(bool additive) = 0;
+
+	/**
+	 * Number of draw calls submitted to the renderer during the last frame.
+	 */
+	uint getLastFrameDrawCalls() const { return _lastFrameDrawCalls; }
 protected:
 	Bitmap *createScreenshotBitmap(const Graphics::PixelBuffer src, int w, int h, bool flipOrientation);
+	void countDrawCall() { _drawCalls++; }
+	// Called by flipBuffer()
+	void endFrameDrawCalls() { _lastFrameDrawCalls = _drawCalls; _drawCalls = 0; }
+	uint _drawCalls, _lastFrameDrawCalls;
 	static const unsigned int _numSpecialtyTextures = 22;
 	Texture _specialtyTextures[_numSpecialtyTextures];
 	static const int _gameHeight = 480;
@@ -288,6 +288,7 @@ void GfxOpenGL::clearDepthBuffer() {
 }
 
 void GfxOpenGL::flipBuffer() {
+	endFrameDrawCalls();
 	g_system->updateScreen();
 }
 
@@ -697,6 +698,7 @@ void GfxOpenGL::drawShadowPlanes() {
 			glVertex3f(shadowSector->getVertices()[k].x(), shadowSector->getVertices()[k].y(), shadowSector->getVertices()[k].z());
 		}
 		glEnd();
+		countDrawCall();
 	}
 	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
@@ -776,6 +778,7 @@ void GfxOpenGL::drawEMIModelFace(const EMIModel *model, const EMIMeshFace *face)
 		glVertex3fv(vertex.getData());
 	}
 	glEnd();
+	countDrawCall();
 
 	if (!_currentShadowArray) {
 		glColor3f(1.0f, 1.0f, 1.0f);
@@ -810,6 +813,7 @@ void GfxOpenGL::drawModelFace(const Mesh *mesh, const MeshFace *face) {
 		glVertex3fv(vertices + 3 * face->getVertex(i));
 	}
 	glEnd();
+	countDrawCall();
 	// Done with transparency-capable objects
 	glDisable(GL_ALPHA_TEST);
 }
@@ -894,6 +898,7 @@ void GfxOpenGL::drawSprite(const Sprite *sprite) {
 		}
 		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 		glEnd();
+		countDrawCall();
 	} else {
 		// In Grim, the bottom edge of the sprite is at y=0 and
 		// the texture is flipped along the X-axis.
@@ -910,6 +915,7 @@ void GfxOpenGL::drawSprite(const Sprite *sprite) {
 		glTexCoord2f(1.0f, 1.0f);
 		glVertex3f(-halfWidth, 0.0f, 0.0f);
 		glEnd();
+		countDrawCall();
 	}
 
 	glEnable(GL_LIGHTING);
@@ -958,6 +964,7 @@ void GfxOpenGL::drawOverlay(const Overlay *overlay) {
 	glTexCoord2f(0.0f, 1.0f);
 	glVertex2f(x, (y + height));
 	glEnd();
+	countDrawCall();
 
 
 
@@ -1199,16 +1206,25 @@ void GfxOpenGL::drawBitmap(const Bitmap *bitmap, int dx, int dy, uint32 layer) {
 
 		assert(layer < data->_numLayers);
 		uint32 offset = data->_layers[layer]._offset;
-		for (uint32 i = offset; i < offset + data->_layers[layer]._numImages; ++i) {
-			glBindTexture(GL_TEXTURE_2D, textures[data->_verts[i]._texid]);
+		uint32 end = offset + data->_layers[layer]._numImages;
+		for (uint32 i = offset; i < end;) {
+			// Consecutive images sharing a texture are drawn together
+			uint32 texid = data->_verts[i]._texid;
+			glBindTexture(GL_TEXTURE_2D, textures[texid]);
 			glBegin(GL_QUADS);
-			uint32 ntex = data->_verts[i]._pos * 4;
-			for (uint32 x = 0; x < data->_verts[i]._verts; ++x) {
-				glTexCoord2f(texc[ntex + 2], texc[ntex + 3]);
-				glVertex2f(texc[ntex + 0], texc[ntex + 1]);
-				ntex += 4;
-			}
+			bool wholeQuads;
+			do {
+				uint32 ntex = data->_verts[i]._pos * 4;
+				for (uint32 x = 0; x < data->_verts[i]._verts; ++x) {
+					glTexCoord2f(texc[ntex + 2], texc[ntex + 3]);
+					glVertex2f(texc[ntex + 0], texc[ntex + 1]);
+					ntex += 4;
+				}
+				wholeQuads = data->_verts[i]._verts % 4 == 0;
+				++i;
+			} while (wholeQuads && i < end && data->_verts[i]._texid == texid);
 			glEnd();
+			countDrawCall();
 		}
 
 		glColor3f(1.0f, 1.0f, 1.0f);
@@ -1293,6 +1309,7 @@ void GfxOpenGL::drawBitmap(const Bitmap *bitmap, int dx, int dy, uint32 layer) {
 			glTexCoord2f(0.0f, 1.0f);
 			glVertex2f(x * _scaleW, (y + BITMAP_TEXTURE_SIZE) * _scaleH);
 			glEnd();
+			countDrawCall();
 			cur_tex_idx++;
 		}
 	}
@@ -1531,6 +1548,7 @@ void GfxOpenGL::drawTextObject(const TextObject *text) {
 			glTexCoord2f(0.0f, 1.0f);
 			glVertex2f(x, (y + height));
 			glEnd();
+			countDrawCall();
 
 
 		}
@@ -1551,6 +1569,10 @@ void GfxOpenGL::drawTextObject(const TextObject *text) {
 	GLuint texture = userData->texture;
 	const Common::String *lines = text->getLines();
 	int numLines = text->getNumLines();
+
+	// All the glyphs are in the font texture, draw the whole text in one go
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glBegin(GL_QUADS);
 	for (int j = 0; j < numLines; ++j) {
 		const Common::String &line = lines[j];
 		int x = text->getLineX(j);
@@ -1563,11 +1585,9 @@ void GfxOpenGL::drawTextObject(const TextObject *text) {
 			float z = x + font->getCharStartingCol(character);
 			z *= _scaleW;
 			w *= _scaleH;
-			glBindTexture(GL_TEXTURE_2D, texture);
 			float width = 1 / 16.f;
 			float cx = ((character - 1) % 16) / 16.0f;
 			float cy = ((character - 1) / 16) / 16.0f;
-			glBegin(GL_QUADS);
 			glTexCoord2f(cx, cy);
 			glVertex2f(z, w);
 			glTexCoord2f(cx + width, cy);
@@ -1576,10 +1596,11 @@ void GfxOpenGL::drawTextObject(const TextObject *text) {
 			glVertex2f(z + sizeW, w + sizeH);
 			glTexCoord2f(cx, cy + width);
 			glVertex2f(z, w + sizeH);
-			glEnd();
 			x += font->getCharKernedWidth(character);
 		}
 	}
+	glEnd();
+	countDrawCall();
 
 	glColor3f(1, 1, 1);
 
@@ -1713,6 +1734,7 @@ void GfxOpenGL::drawDepthBitmap(int x, int y, int w, int h, char *data) {
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 2); // 16 bit Z depth bitmap
 
 	glDrawPixels(w, h, GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, data);
+	countDrawCall();
 
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -1862,6 +1884,7 @@ void GfxOpenGL::drawMovieFrame(int offsetX, int offsetY) {
 			glTexCoord2f(0.0f, 1.0f);
 			glVertex2f(x + offsetX, y + offsetY + BITMAP_TEXTURE_SIZE * _scaleH);
 			glEnd();
+			countDrawCall();
 			curTexIdx++;
 		}
 	}
@@ -1913,6 +1936,7 @@ void GfxOpenGL::drawEmergString(int x, int y, const char *text, const Color &fgC
 	
 	char *list = const_cast<char *>(text);
 	glCallLists(strlen(text), GL_UNSIGNED_BYTE, (void *)list);
+	countDrawCall();
 
 	glEnable(GL_LIGHTING);
 
@@ -1948,6 +1972,7 @@ void GfxOpenGL::copyStoredToDisplay() {
 	glRasterPos2i(0, _screenHeight - 1);
 	glBitmap(0, 0, 0, 0, 0, -1, nullptr);
 	glDrawPixels(_screenWidth, _screenHeight, GL_RGBA, GL_UNSIGNED_BYTE, _storedDisplay);
+	countDrawCall();
 
 	glDepthMask(GL_TRUE);
 	glEnable(GL_DEPTH_TEST);
@@ -2020,6 +2045,7 @@ void GfxOpenGL::dimRegion(int x, int yReal, int w, int h, float level) {
 		glTexCoord2f(0.0f, 1.0f);
 		glVertex2f(x, y + h);
 		glEnd();
+		countDrawCall();
 
 		glDisable(GL_FRAGMENT_PROGRAM_ARB);
 
@@ -2058,6 +2084,7 @@ void GfxOpenGL::dimRegion(int x, int yReal, int w, int h, float level) {
 	// Set the raster position and draw the bitmap
 	glRasterPos2i(x, yReal + h);
 	glDrawPixels(w, h, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	countDrawCall();
 
 	glDepthMask(GL_TRUE);
 	glEnable(GL_DEPTH_TEST);
@@ -2106,6 +2133,7 @@ void GfxOpenGL::irisAroundRegion(int x1, int y1, int x2, int y2) {
 		glVertex2fv(points+2*i);
 	}
 	glEnd();
+	countDrawCall();
 
 	glColor3f(1.0f, 1.0f, 1.0f);
 	glEnable(GL_DEPTH_TEST);
@@ -2139,6 +2167,7 @@ void GfxOpenGL::drawRectangle(const PrimitiveObject *primitive) {
 		glVertex2f(x2 + 1, y2 + 1);
 		glVertex2f(x1, y2 + 1);
 		glEnd();
+		countDrawCall();
 	} else {
 		glLineWidth(_scaleW);
 		glBegin(GL_LINE_LOOP);
@@ -2147,6 +2176,7 @@ void GfxOpenGL::drawRectangle(const PrimitiveObject *primitive) {
 		glVertex2f(x2 + 1, y2 + 1);
 		glVertex2f(x1, y2 + 1);
 		glEnd();
+		countDrawCall();
 	}
 
 	glColor3f(1.0f, 1.0f, 1.0f);
@@ -2182,6 +2212,7 @@ void GfxOpenGL::drawLine(const PrimitiveObject *primitive) {
 	glVertex2f(x1, y1);
 	glVertex2f(x2, y2);
 	glEnd();
+	countDrawCall();
 
 	glColor3f(1.0f, 1.0f, 1.0f);
 
@@ -2214,6 +2245,7 @@ void GfxOpenGL::drawDimPlane() {
 	glVertex2f(1.0, 1.0);
 	glVertex2f(0, 1.0);
 	glEnd();
+	countDrawCall();
 
 	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 
@@ -2256,6 +2288,7 @@ void GfxOpenGL::drawPolygon(const PrimitiveObject *primitive) {
 	glVertex2f(x3, y3 + 1);
 	glVertex2f(x4 + 1, y4);
 	glEnd();
+	countDrawCall();
 
 	glColor3f(1.0f, 1.0f, 1.0f);
 
@@ -515,6 +515,7 @@ void GfxOpenGLS::clearDepthBuffer() {
 }
 
 void GfxOpenGLS::flipBuffer() {
+	endFrameDrawCalls();
 	g_system->updateScreen();
 }
 
@@ -854,6 +855,7 @@ void GfxOpenGLS::drawShadowPlanes() {
 	glEnableVertexAttribArray(attribPos);
 	glVertexAttribPointer(attribPos, 3, GL_FLOAT, GL_TRUE, 3 * sizeof(float), 0);
 	glDrawElements(GL_TRIANGLES, 3 * sud->_numTriangles, GL_UNSIGNED_SHORT, 0);
+	countDrawCall();
 
 	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
@@ -956,6 +958,7 @@ void GfxOpenGLS::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, face->_indicesEBO);
 
 	glDrawElements(GL_TRIANGLES, 3 * face->_faceLength, GL_UNSIGNED_SHORT, 0);
+	countDrawCall();
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
@@ -991,6 +994,7 @@ void GfxOpenGLS::drawMesh(const Mesh *mesh) {
 		actorShader->setUniform("texScale", Math::Vector2d(_selectedTexture->_width, _selectedTexture->_height));
 
 		glDrawArrays(GL_TRIANGLES, *(int *)face->_userData, faces);
+		countDrawCall();
 	}
 }
 
@@ -1008,6 +1012,7 @@ void GfxOpenGLS::drawDimPlane() {
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadEBO);
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+	countDrawCall();
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 	glEnable(GL_DEPTH_TEST);
@@ -1069,6 +1074,7 @@ void GfxOpenGLS::drawSprite(const Sprite *sprite) {
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadEBO);
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+	countDrawCall();
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	glEnable(GL_DEPTH_TEST);
 	glDepthMask(GL_TRUE);
@@ -1338,6 +1344,7 @@ void GfxOpenGLS::drawBitmap(const Bitmap *bitmap, int dx, int dy, uint32 layer)
 			unsigned short startVertex = data->_verts[i]._pos / 4 * 6;
 			unsigned short numVertices = data->_verts[i]._verts / 4 * 6;
 			glDrawElements(GL_TRIANGLES, numVertices, GL_UNSIGNED_SHORT, (void *)(startVertex * sizeof(unsigned short)));
+			countDrawCall();
 		}
 		return;
 	}
@@ -1370,6 +1377,7 @@ void GfxOpenGLS::drawBitmap(const Bitmap *bitmap, int dx, int dy, uint32 layer)
 		shader->setUniform("sizeWH", Math::Vector2d(width / _gameWidth, height / _gameHeight));
 		shader->setUniform("texcrop", Math::Vector2d(width / nextHigher2((int)width), height / nextHigher2((int)height)));
 		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+		countDrawCall();
 
 		glDisable(GL_BLEND);
 		glDepthMask(GL_TRUE);
@@ -1603,6 +1611,7 @@ void GfxOpenGLS::drawTextObject(const TextObject *text) {
 	glBindTexture(GL_TEXTURE_2D, td->texture);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadEBO);
 	glDrawElements(GL_TRIANGLES, td->characters * 6, GL_UNSIGNED_SHORT, 0);
+	countDrawCall();
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	glEnable(GL_DEPTH_TEST);
 }
@@ -1640,6 +1649,7 @@ void GfxOpenGLS::copyStoredToDisplay() {
 	glDepthMask(GL_FALSE);
 
 	glDrawArrays(GL_TRIANGLES, 0, 6);
+	countDrawCall();
 
 	glEnable(GL_DEPTH_TEST);
 	glDepthMask(GL_TRUE);
@@ -1691,6 +1701,7 @@ void GfxOpenGLS::dimRegion(int xin, int yReal, int w, int h, float level) {
 	glDepthMask(GL_FALSE);
 
 	glDrawArrays(GL_TRIANGLES, 0, 6);
+	countDrawCall();
 
 	glEnable(GL_DEPTH_TEST);
 	glDepthMask(GL_TRUE);
@@ -1730,6 +1741,7 @@ void GfxOpenGLS::irisAroundRegion(int x1, int y1, int x2, int y2) {
 	glDepthMask(GL_FALSE);
 
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 10);
+	countDrawCall();
 
 	glEnable(GL_DEPTH_TEST);
 	glDepthMask(GL_TRUE);
@@ -1757,6 +1769,7 @@ void GfxOpenGLS::drawEmergString(int x, int y, const char *text, const Color &fg
 		_emergProgram->setUniform("offsetXY", Math::Vector2d(float(x) / _gameWidth, float(y) / _gameHeight));
 		_emergProgram->setUniform("texOffsetXY", Math::Vector2d(float(blockcol * 8) / 128, float(blockrow * 16) / 128));
 		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+		countDrawCall();
 	}
 }
 
@@ -1812,12 +1825,15 @@ void GfxOpenGLS::drawGenericPrimitive(const float *vertices, uint32 numVertices,
 	switch (primitive->getType()) {
 		case PrimitiveObject::RectangleType:
 			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			countDrawCall();
 			break;
 		case PrimitiveObject::LineType:
 			glDrawArrays(GL_LINES, 0, 2);
+			countDrawCall();
 			break;
 		case PrimitiveObject::PolygonType:
 			glDrawArrays(GL_LINES, 0, 4);
+			countDrawCall();
 			break;
 		default:
 			// Impossible
@@ -1964,6 +1980,7 @@ void GfxOpenGLS::drawMovieFrame(int offsetX, int offsetY) {
 	glBindTexture(GL_TEXTURE_2D, _smushTexId);
 
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+	countDrawCall();
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	glEnable(GL_DEPTH_TEST);
@@ -58,9 +58,6 @@ GfxTinyGL::GfxTinyGL() :
 	// refer to the same vertices. The first face is usually using the
 	// color map and the following are using textures.
 	_depthFunc = (g_grim->getGameType() == GType_MONKEY4) ? TGL_LEQUAL : TGL_LESS;
-	for (int i = 0; i < 96; i++) {
-		_emergFont[i] = nullptr;
-	}
 }
 
 GfxTinyGL::~GfxTinyGL() {
@@ -68,9 +65,8 @@ GfxTinyGL::~GfxTinyGL() {
 	for (unsigned int i = 0; i < _numSpecialtyTextures; i++) {
 		destroyTexture(&_specialtyTextures[i]);
 	}
-	for (int i = 0; i < 96; i++) {
-		Graphics::tglDeleteBlitImage(_emergFont[i]);
-	}
+	clearEmergStrings();
+	_emergFont.free();
 	if (_zb) {
 		TinyGL::glClose();
 		delete _zb;
@@ -174,6 +170,7 @@ void GfxTinyGL::clearDepthBuffer() {
 
 void GfxTinyGL::flipBuffer() {
 	TinyGL::tglPresentBuffer();
+	endFrameDrawCalls();
 	g_system->copyRectToScreen(_zb->getPixelBuffer(), _zb->linesize,
 	                           0, 0, _zb->xsize, _zb->ysize);
 	g_system->updateScreen();
@@ -568,6 +565,7 @@ void GfxTinyGL::drawShadowPlanes() {
 			tglVertex3f(shadowSector->getVertices()[k].x(), shadowSector->getVertices()[k].y(), shadowSector->getVertices()[k].z());
 		}
 		tglEnd();
+		countDrawCall();
 	}
 	tglSetShadowMaskBuf(nullptr);
 	tglDisable(TGL_SHADOW_MASK_MODE);
@@ -654,6 +652,7 @@ void GfxTinyGL::drawEMIModelFace(const EMIModel *model, const EMIMeshFace *face)
 		tglVertex3fv(vertex.getData());
 	}
 	tglEnd();
+	countDrawCall();
 
 	if (!_currentShadowArray) {
 		tglColor3f(1.0f, 1.0f, 1.0f);
@@ -688,6 +687,7 @@ void GfxTinyGL::drawModelFace(const Mesh *mesh, const MeshFace *face) {
 		tglVertex3fv(vertices + 3 * face->getVertex(i));
 	}
 	tglEnd();
+	countDrawCall();
 	// Done with transparency-capable objects
 	tglDisable(TGL_ALPHA_TEST);
 }
@@ -772,6 +772,7 @@ void GfxTinyGL::drawSprite(const Sprite *sprite) {
 			tglVertex3f(vertexX[i] * halfWidth, vertexY[i] * halfHeight, 0.0f);
 		}
 		tglEnd();
+		countDrawCall();
 		tglColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 	} else {
 		// In Grim, the bottom edge of the sprite is at y=0 and
@@ -789,8 +790,77 @@ void GfxTinyGL::drawSprite(const Sprite *sprite) {
 		tglTexCoord2f(1.0f, 1.0f);
 		tglVertex3f(-halfWidth, 0.0f, 0.0f);
 		tglEnd();
+		countDrawCall();
+	}
+
+	tglEnable(TGL_LIGHTING);
+	tglDisable(TGL_ALPHA_TEST);
+	tglDepthMask(TGL_TRUE);
+	tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+	tglDisable(TGL_BLEND);
+	tglEnable(TGL_DEPTH_TEST);
+
+	tglPopMatrix();
+}
+
+void GfxTinyGL::drawSprites(const Sprite *const *sprites, int count) {
+	if (count == 1 || g_grim->getGameType() != GType_GRIM) {
+		GfxBase::drawSprites(sprites, count);
+		return;
+	}
+
+	tglMatrixMode(TGL_TEXTURE);
+	tglLoadIdentity();
+	tglMatrixMode(TGL_MODELVIEW);
+	tglPushMatrix();
+
+	// Screen-aligned sprites only keep the translation of their modelview
+	// matrix, so all of them can be drawn with an identity matrix once
+	// their positions have been moved to view space.
+	TGLfloat modelview[16];
+	tglGetFloatv(TGL_MODELVIEW_MATRIX, modelview);
+	tglLoadIdentity();
+
+	const Sprite *first = sprites[0];
+	if (first->_flags1 & Sprite::BlendAdditive) {
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE);
+	} else {
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	tglDisable(TGL_LIGHTING);
+	tglEnable(TGL_ALPHA_TEST);
+	tglAlphaFunc(TGL_GEQUAL, 0.5f);
+
+	if (first->_flags2 & Sprite::DepthTest) {
+		tglEnable(TGL_DEPTH_TEST);
+	} else {
+		tglDisable(TGL_DEPTH_TEST);
 	}
 
+	// In Grim, the bottom edge of the sprite is at y=0 and
+	// the texture is flipped along the X-axis.
+	tglBegin(TGL_QUADS);
+	for (int i = 0; i < count; i++) {
+		const Math::Vector3d &pos = sprites[i]->_pos;
+		float x = modelview[0] * pos.x() + modelview[4] * pos.y() + modelview[8] * pos.z() + modelview[12];
+		float y = modelview[1] * pos.x() + modelview[5] * pos.y() + modelview[9] * pos.z() + modelview[13];
+		float z = modelview[2] * pos.x() + modelview[6] * pos.y() + modelview[10] * pos.z() + modelview[14];
+		float halfWidth = sprites[i]->_width / 2;
+		float height = sprites[i]->_height;
+
+		tglTexCoord2f(0.0f, 1.0f);
+		tglVertex3f(x + halfWidth, y, z);
+		tglTexCoord2f(0.0f, 0.0f);
+		tglVertex3f(x + halfWidth, y + height, z);
+		tglTexCoord2f(1.0f, 0.0f);
+		tglVertex3f(x - halfWidth, y + height, z);
+		tglTexCoord2f(1.0f, 1.0f);
+		tglVertex3f(x - halfWidth, y, z);
+	}
+	tglEnd();
+	countDrawCall();
+
 	tglEnable(TGL_LIGHTING);
 	tglDisable(TGL_ALPHA_TEST);
 	tglDepthMask(TGL_TRUE);
@@ -959,6 +1029,7 @@ void GfxTinyGL::drawBitmap(const Bitmap *bitmap, int x, int y, uint32 layer) {
 				transform.sourceRectangle(srcX, srcY, dx2 - dx1, dy2 - dy1);
 				transform.tint(1.0f, 1.0f - _dimLevel, 1.0f - _dimLevel, 1.0f  - _dimLevel);
 				Graphics::tglBlit(b[texId], transform);
+				countDrawCall();
 				ntex += 16;
 			}
 		}
@@ -983,11 +1054,13 @@ void GfxTinyGL::drawBitmap(const Bitmap *bitmap, int x, int y, uint32 layer) {
 			tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
 		}
 		Graphics::tglBlit(b[num], x, y);
+		countDrawCall();
 		if (bitmap->getHasTransparency()) {
 			tglDisable(TGL_BLEND);
 		}
 	} else {
 		Graphics::tglBlitZBuffer(b[num], x, y);
+		countDrawCall();
 	}
 }
 
@@ -1101,6 +1174,7 @@ void GfxTinyGL::drawTextObject(const TextObject *text) {
 		int numLines = text->getNumLines();
 		for (int i = 0; i < numLines; ++i) {
 			Graphics::tglBlit(userData[i].image, userData[i].x, userData[i].y);
+			countDrawCall();
 		}
 		tglDisable(TGL_BLEND);
 	}
@@ -1213,6 +1287,7 @@ void GfxTinyGL::prepareMovieFrame(Graphics::Surface *frame) {
 
 void GfxTinyGL::drawMovieFrame(int offsetX, int offsetY) {
 	Graphics::tglBlitFast(_smushImage, offsetX, offsetY);
+	countDrawCall();
 }
 
 void GfxTinyGL::releaseMovieFrame() {
@@ -1220,38 +1295,63 @@ void GfxTinyGL::releaseMovieFrame() {
 }
 
 void GfxTinyGL::loadEmergFont() {
-	Graphics::Surface characterSurface;
 	Graphics::PixelFormat textureFormat(4, 8, 8, 8, 8, 0, 8, 16, 24);
-	characterSurface.create(8, 13, textureFormat);
+	_emergFont.create(8 * 96, 13, textureFormat);
 	uint32 color = textureFormat.ARGBToColor(255, 255, 255, 255);
 	uint32 colorTransparent = textureFormat.ARGBToColor(0, 255, 255, 255);
 	for (int i = 0; i < 96; i++) {
-		_emergFont[i] = Graphics::tglGenBlitImage();
 		const uint8 *ptr = Font::emerFont[i];
 		for (int py = 0; py < 13; py++) {
 				int line = ptr[12 - py];
 				for (int px = 0; px < 8; px++) {
 					int pixel = line & 0x80;
 					line <<= 1;
-					*(uint32 *)characterSurface.getBasePtr(px, py) = pixel ? color : colorTransparent;
+					*(uint32 *)_emergFont.getBasePtr(i * 8 + px, py) = pixel ? color : colorTransparent;
 				}
 		}
-		Graphics::tglUploadBlitImage(_emergFont[i], characterSurface, 0, false);
 	}
-	characterSurface.free();
 }
 
 void GfxTinyGL::drawEmergString(int x, int y, const char *text, const Color &fgColor) {
 	int length = strlen(text);
+	if (length == 0)
+		return;
+
+	// Strings like the FPS counter are drawn every frame, so each one is
+	// rendered into an image once and then drawn with a single blit
+	Graphics::BlitImage *image;
+	EmergStringMap::const_iterator it = _emergStrings.find(text);
+	if (it != _emergStrings.end()) {
+		image = it->_value;
+	} else {
+		if (_emergStrings.size() >= 16)
+			clearEmergStrings();
+
+		Graphics::Surface stringSurface;
+		stringSurface.create(length * 10 - 2, 13, _emergFont.format);
+		stringSurface.fillRect(Common::Rect(stringSurface.w, stringSurface.h), _emergFont.format.ARGBToColor(0, 255, 255, 255));
+		for (int l = 0; l < length; l++) {
+			int c = text[l];
+			assert(c >= 32 && c <= 127);
+			stringSurface.copyRectToSurface(_emergFont, l * 10, 0, Common::Rect((c - 32) * 8, 0, (c - 32) * 8 + 8, 13));
+		}
+		image = Graphics::tglGenBlitImage();
+		Graphics::tglUploadBlitImage(image, stringSurface, 0, false);
+		stringSurface.free();
+		_emergStrings[text] = image;
+	}
+
+	Graphics::BlitTransform transform(x, y);
+	transform.tint(1.0f, fgColor.getRed() / 255.0f, fgColor.getGreen() / 255.0f, fgColor.getBlue() / 255.0f);
+	Graphics::tglBlit(image, transform);
+	countDrawCall();
+}
 
-	for (int l = 0; l < length; l++) {
-		int c = text[l];
-		assert(c >= 32 && c <= 127);
-		Graphics::BlitTransform transform(x, y);
-		transform.tint(1.0f, fgColor.getRed() / 255.0f, fgColor.getGreen() / 255.0f, fgColor.getBlue() / 255.0f);
-		Graphics::tglBlit(_emergFont[c - 32], transform);
-		x += 10;
+void GfxTinyGL::clearEmergStrings() {
+	for (EmergStringMap::iterator it = _emergStrings.begin(); it != _emergStrings.end(); ++it) {
+		Graphics::tglDeleteBlitImage(it->_value);
 	}
+	_emergStrings.clear();
 }
 
 Bitmap *GfxTinyGL::getScreenshot(int w, int h, bool useStored) {
@@ -1305,6 +1405,7 @@ void GfxTinyGL::dimRegion(int x, int y, int w, int h, float level) {
 	tglVertex2f(x + w, y + h);
 	tglVertex2f(x, y + h);
 	tglEnd();
+	countDrawCall();
 
 	tglColor3f(1.0f, 1.0f, 1.0f);
 
@@ -1352,6 +1453,7 @@ void GfxTinyGL::irisAroundRegion(int x1, int y1, int x2, int y2) {
 	tglEnableClientState(TGL_VERTEX_ARRAY);
 	tglVertexPointer(2, TGL_FLOAT, 0, points);
 	tglDrawArrays(TGL_TRIANGLE_STRIP, 0, 10);
+	countDrawCall();
 	tglDisableClientState(TGL_VERTEX_ARRAY);
 
 	tglColor3f(1.0f, 1.0f, 1.0f);
@@ -1386,6 +1488,7 @@ void GfxTinyGL::drawRectangle(const PrimitiveObject *primitive) {
 		tglVertex2f(x2 + 1, y2 + 1);
 		tglVertex2f(x1, y2 + 1);
 		tglEnd();
+		countDrawCall();
 	} else {
 		tglBegin(TGL_LINE_LOOP);
 		tglVertex2f(x1, y1);
@@ -1393,6 +1496,7 @@ void GfxTinyGL::drawRectangle(const PrimitiveObject *primitive) {
 		tglVertex2f(x2 + 1, y2 + 1);
 		tglVertex2f(x1, y2 + 1);
 		tglEnd();
+		countDrawCall();
 	}
 
 	tglColor3f(1.0f, 1.0f, 1.0f);
@@ -1428,6 +1532,7 @@ void GfxTinyGL::drawLine(const PrimitiveObject *primitive) {
 	tglVertex2f(x1, y1);
 	tglVertex2f(x2, y2);
 	tglEnd();
+	countDrawCall();
 
 	tglColor3f(1.0f, 1.0f, 1.0f);
 
@@ -1460,6 +1565,7 @@ void GfxTinyGL::drawDimPlane() {
 	tglVertex2f(1.0, 1.0);
 	tglVertex2f(-1, 1.0);
 	tglEnd();
+	countDrawCall();
 
 	tglColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 
@@ -1499,6 +1605,7 @@ void GfxTinyGL::drawPolygon(const PrimitiveObject *primitive) {
 	tglVertex2f(x3, y3 + 1);
 	tglVertex2f(x4 + 1, y4);
 	tglEnd();
+	countDrawCall();
 
 	tglColor3f(1.0f, 1.0f, 1.0f);
 
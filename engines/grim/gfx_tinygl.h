@@ -25,6 +25,10 @@
 
 #include "engines/grim/gfx_base.h"
 
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+#include "graphics/surface.h"
 #include "graphics/tinygl/zgl.h"
 
 namespace Grim {
@@ -81,6 +85,7 @@ public:
 	void drawEMIModelFace(const EMIModel *model, const EMIMeshFace *face) override;
 	void drawModelFace(const Mesh *mesh, const MeshFace *face) override;
 	void drawSprite(const Sprite *sprite) override;
+	void drawSprites(const Sprite *const *sprites, int count) override;
 
 	void enableLights() override;
 	void disableLights() override;
@@ -130,7 +135,12 @@ protected:
 private:
 	TinyGL::FrameBuffer *_zb;
 	Graphics::PixelFormat _pixelFormat;
-	Graphics::BlitImage *_emergFont[96];
+	// All the characters of the emergency font, side by side
+	Graphics::Surface _emergFont;
+	// Recently drawn emergency font strings, each rendered into one image
+	typedef Common::HashMap<Common::String, Graphics::BlitImage *> EmergStringMap;
+	EmergStringMap _emergStrings;
+	void clearEmergStrings();
 	Graphics::BlitImage *_smushImage;
 	Graphics::PixelBuffer _storedDisplay;
 	float _alpha;
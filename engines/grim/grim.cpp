@@ -1123,8 +1123,17 @@ void GrimEngine::mainLoop() {
 		if (startTime > endTime)
 			continue;
 		uint32 diffTime = endTime - startTime;
-		if (_speedLimitMs == 0)
+		if (_speedLimitMs == 0) {
+			// Without a frame limit there is no idle time to spend, so give
+			// the read ahead a fixed millisecond per frame instead
+			g_resourceloader->processPrefetchQueue(1);
 			continue;
+		}
+		if (diffTime < _speedLimitMs) {
+			// Spend the rest of the frame reading ahead the files of the loaded sets
+			g_resourceloader->processPrefetchQueue(_speedLimitMs - diffTime);
+			diffTime = g_system->getMillis() - startTime;
+		}
 		if (diffTime < _speedLimitMs) {
 			uint32 delayTime = _speedLimitMs - diffTime;
 			g_system->delayMillis(delayTime);
@@ -49,6 +49,9 @@
 
 namespace Grim {
 
+// Objects traversed per frame by an incremental Lua collection
+static const int32 kLuaGCFrameWork = 2000;
+
 void LuaObjects::add(float number) {
 	Obj obj;
 	obj._type = Obj::Number;
@@ -266,8 +269,12 @@ void LuaBase::update(int frameTime, int movieTime) {
 	_frameTimeCollection += frameTime;
 	if (_frameTimeCollection > 10000) {
 		_frameTimeCollection = 0;
-		lua_collectgarbage(0);
+		if (lua_getgcmode() == LUA_GC_INCREMENTAL)
+			lua_gcstart();
+		else
+			lua_collectgarbage(0);
 	}
+	lua_gcstep(kLuaGCFrameWork);
 
 	lua_beginblock();
 	setFrameTime(frameTime);
@@ -17,6 +17,8 @@
 #include "engines/grim/lua/ltm.h"
 #include "engines/grim/lua/lua.h"
 
+#include "common/system.h"
+
 namespace Grim {
 
 static int32 markobject (TObject *o);
@@ -150,55 +152,60 @@ static void strmark(TaggedString *s) {
 		s->head.marked = 1;
 }
 
-static void protomark(TProtoFunc *f) {
-	if (!f->head.marked) {
-		LocVar *v = f->locvars;
-		int32 i;
-		f->head.marked = 1;
-		if (f->fileName)
-			strmark(f->fileName);
-		for (i = 0; i < f->nconsts; i++)
-			markobject(&f->consts[i]);
-		if (v) {
-			for (; v->line != -1; v++) {
-				if (v->varname)
-					strmark(v->varname);
-			}
-		}
-	}
-}
+/*
+** =======================================================
+** Incremental collection
+** =======================================================
+** Tables, closures and protos go through three colors: white (marked == 0),
+** gray (GCGRAY, waiting in the gray stack for their children to be marked)
+** and black (marked == 1). Strings have no children and are made black
+** right away. In incremental mode the gray stack is drained a bit at a time,
+** between the Lua code which keeps running. Tables are the only objects that
+** can change once created, luaH_set() turns a black table gray again through
+** luaC_barrierback(). Such tables are only traversed again in the atomic
+** step, so a big table written to in a loop isn't traversed over and over.
+** The roots (stacks,
+** globals, refs and tag methods) are not protected by barriers, they are
+** marked again in the atomic step that ends the cycle, right before the sweep.
+*/
+
+#define GCGRAY		3
+#define GCSTEPWORK	1024	// work done when the allocation threshold is hit
+#define GCSTEPBLOCKS	64	// blocks allocated between two steps
+
+int32 GCstate = GCSpause;
+static int32 GCmode = LUA_GC_FULL; // incremental mode is enabled with the lua_gc debugger command
+struct GrayStack {
+	TObject *stack;
+	int32 size;
+	int32 top;
+};
+
+static GrayStack gray = { nullptr, 0, 0 };
+static GrayStack grayagain = { nullptr, 0, 0 };  // tables written to while black
 
-static void closuremark(Closure *f) {
-	if (!f->head.marked) {
-		int32 i;
-		f->head.marked = 1;
-		for (i = f->nelems; i >= 0; i--)
-			markobject(&f->consts[i]);
+static lua_GCStats GCstats;
+
+static void graypush(GrayStack *g, lua_Type type, GCnode *o) {
+	if (g->top == g->size) {
+		g->size = g->size ? g->size * 2 : 256;
+		g->stack = (TObject *)luaM_realloc(g->stack, g->size * sizeof(TObject));
 	}
+	o->marked = GCGRAY;
+	ttype(&g->stack[g->top]) = type;
+	g->stack[g->top].value.ts = (TaggedString *)o;
+	g->top++;
 }
 
-static void hashmark(Hash *h) {
-	if (!h->head.marked) {
-		int32 i;
-		h->head.marked = 1;
-		for (i = 0; i < nhash(h); i++) {
-			Node *n = node(h, i);
-			if (ttype(ref(n)) != LUA_T_NIL) {
-				markobject(&n->ref);
-				markobject(&n->val);
-			}
-		}
-	}
+static void grayfree(GrayStack *g) {
+	luaM_free(g->stack);
+	g->stack = nullptr;
+	g->size = 0;
+	g->top = 0;
 }
 
-static void globalmark() {
-	TaggedString *g;
-	for (g = (TaggedString *)rootglobal.next; g; g = (TaggedString *)g->head.next){
-		if (g->globalval.ttype != LUA_T_NIL) {
-			markobject(&g->globalval);
-			strmark(g);  // cannot collect non nil global variables
-		}
-	}
+void luaC_barrierback(Hash *t) {
+	graypush(&grayagain, LUA_T_ARRAY, &t->head);
 }
 
 static int32 markobject(TObject *o) {
@@ -207,15 +214,18 @@ static int32 markobject(TObject *o) {
 		strmark(tsvalue(o));
 		break;
 	case LUA_T_ARRAY:
-		hashmark(avalue(o));
+		if (!avalue(o)->head.marked)
+			graypush(&gray, LUA_T_ARRAY, &avalue(o)->head);
 		break;
 	case LUA_T_CLOSURE:
 	case LUA_T_CLMARK:
-		closuremark(o->value.cl);
+		if (!o->value.cl->head.marked)
+			graypush(&gray, LUA_T_CLOSURE, &o->value.cl->head);
 		break;
 	case LUA_T_PROTO:
 	case LUA_T_PMARK:
-		protomark(o->value.tf);
+		if (!o->value.tf->head.marked)
+			graypush(&gray, LUA_T_PROTO, &o->value.tf->head);
 		break;
 	default:
 		break;  // numbers, cprotos, etc
@@ -223,6 +233,74 @@ static int32 markobject(TObject *o) {
 	return 0;
 }
 
+static int32 protomark(TProtoFunc *f) {
+	LocVar *v = f->locvars;
+	int32 i;
+	if (f->fileName)
+		strmark(f->fileName);
+	for (i = 0; i < f->nconsts; i++)
+		markobject(&f->consts[i]);
+	if (v) {
+		for (; v->line != -1; v++) {
+			if (v->varname)
+				strmark(v->varname);
+		}
+	}
+	return 1 + f->nconsts;
+}
+
+static int32 closuremark(Closure *f) {
+	int32 i;
+	for (i = f->nelems; i >= 0; i--)
+		markobject(&f->consts[i]);
+	return 2 + f->nelems;
+}
+
+static int32 hashmark(Hash *h) {
+	int32 i;
+	for (i = 0; i < nhash(h); i++) {
+		Node *n = node(h, i);
+		if (ttype(ref(n)) != LUA_T_NIL) {
+			markobject(&n->ref);
+			markobject(&n->val);
+		}
+	}
+	return 1 + nhash(h);
+}
+
+/*
+** Make the object on top of the gray stack black, returns the work done
+*/
+static int32 propagatemark() {
+	TObject *o = &gray.stack[--gray.top];
+	switch (ttype(o)) {
+	case LUA_T_ARRAY:
+		avalue(o)->head.marked = 1;
+		return hashmark(avalue(o));
+	case LUA_T_CLOSURE:
+		o->value.cl->head.marked = 1;
+		return closuremark(o->value.cl);
+	default:
+		o->value.tf->head.marked = 1;
+		return protomark(o->value.tf);
+	}
+}
+
+static void propagateall() {
+	while (gray.top > 0)
+		propagatemark();
+}
+
+static void globalmark() {
+	TaggedString *g;
+	for (g = (TaggedString *)rootglobal.next; g; g = (TaggedString *)g->head.next){
+		if (g->globalval.ttype != LUA_T_NIL) {
+			markobject(&g->globalval);
+			strmark(g);  // cannot collect non nil global variables
+		}
+	}
+}
+
 static void markall() {
 	luaD_travstack(markobject); // mark stack objects
 	globalmark();  // mark global variable values and names
@@ -230,13 +308,22 @@ static void markall() {
 	luaT_travtagmethods(markobject);  // mark fallbacks
 }
 
-int32 lua_collectgarbage(int32 limit) {
+/*
+** Mark what is still reachable and free the rest
+*/
+static int32 collect(int32 limit) {
 	int32 recovered = nblocks;  // to subtract nblocks after gc
 	Hash *freetable;
 	TaggedString *freestr;
 	TProtoFunc *freefunc;
 	Closure *freeclos;
 	markall();
+	while (grayagain.top > 0) {
+		Hash *t = avalue(&grayagain.stack[--grayagain.top]);
+		graypush(&gray, LUA_T_ARRAY, &t->head);
+	}
+	propagateall();
+	GCstate = GCSpause;
 	invalidaterefs();
 	freestr = luaS_collector();
 	freetable = (Hash *)listcollect(&roottable);
@@ -252,12 +339,91 @@ int32 lua_collectgarbage(int32 limit) {
 	luaF_freeclosure(freeclos);
 	recovered = recovered - nblocks;
 	GCthreshold = (limit == 0) ? 2 * nblocks : nblocks + limit;
+	GCstats.cycles++;
+	return recovered;
+}
+
+static void startcycle() {
+	markall();
+	GCstate = GCSpropagate;
+}
+
+/*
+** Drain the gray stack for about work units, ending the cycle once
+** it's empty. Returns true if the cycle ended.
+*/
+static bool incrementalstep(int32 work) {
+	while (gray.top > 0 && work > 0)
+		work -= propagatemark();
+	if (gray.top > 0)
+		return false;
+	collect(0);
+	return true;
+}
+
+static void recordpause(uint32 startTime) {
+	uint32 pause = g_system->getMillis() - startTime;
+	GCstats.lastPause = pause;
+	GCstats.totalPause += pause;
+	if (pause > GCstats.maxPause)
+		GCstats.maxPause = pause;
+}
+
+int32 lua_collectgarbage(int32 limit) {
+	uint32 startTime = g_system->getMillis();
+	// An incremental cycle in progress is finished, the objects
+	// already marked are still reachable
+	int32 recovered = collect(limit);
+	recordpause(startTime);
 	return recovered;
 }
 
+void lua_setgcmode(int32 mode) {
+	GCmode = mode;
+}
+
+int32 lua_getgcmode() {
+	return GCmode;
+}
+
+void lua_gcstart() {
+	if (GCstate == GCSpause) {
+		uint32 startTime = g_system->getMillis();
+		startcycle();
+		recordpause(startTime);
+	}
+}
+
+int32 lua_gcstep(int32 work) {
+	if (GCstate == GCSpause)
+		return 0;
+	uint32 startTime = g_system->getMillis();
+	GCstats.steps++;
+	bool finished = incrementalstep(work);
+	recordpause(startTime);
+	return finished;
+}
+
+void lua_getgcstats(lua_GCStats *stats) {
+	*stats = GCstats;
+}
+
+void luaC_resetgc() {
+	grayfree(&gray);
+	grayfree(&grayagain);
+	GCstate = GCSpause;
+}
+
 void luaC_checkGC() {
-	if (nblocks >= GCthreshold)
+	if (nblocks < GCthreshold)
+		return;
+	if (GCmode == LUA_GC_INCREMENTAL) {
+		lua_gcstart();
+		if (!lua_gcstep(GCSTEPWORK))
+			GCthreshold = nblocks + GCSTEPBLOCKS;
+	} else {
 		lua_collectgarbage(0);
+	}
 }
 
 } // end of namespace Grim
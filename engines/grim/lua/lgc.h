@@ -11,7 +11,19 @@
 
 namespace Grim {
 
+enum {
+	GCSpause,
+	GCSpropagate
+};
+
+extern int32 GCstate;
+
+// Called before a black table gets written to while marking incrementally
+#define luaC_barriert(t)	{ if ((t)->head.marked == 1 && GCstate == GCSpropagate) luaC_barrierback(t); }
+
 void luaC_checkGC();
+void luaC_barrierback(Hash *t);
+void luaC_resetgc();
 TObject* luaC_getref(int32 r);
 int32 luaC_ref(TObject *o, int32 lock);
 void luaC_hashcallIM(Hash *l);
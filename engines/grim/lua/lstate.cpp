@@ -132,6 +132,7 @@ void lua_resetglobals() {
 	refSize = 0;
 	GCthreshold = GARBAGE_BLOCK;
 	nblocks = 0;
+	luaC_resetgc();
 
 	luaD_init();
 	luaS_init();
@@ -212,6 +213,7 @@ void lua_open() {
 
 void lua_close() {
 	TaggedString *alludata = luaS_collectudata();
+	luaC_resetgc();
 	GCthreshold = MAX_INT;  // to avoid GC during GC
 	luaC_hashcallIM((Hash *)roottable.next);  // GC t.methods for tables
 	luaC_strcallIM(alludata);  // GC tag methods for userdata
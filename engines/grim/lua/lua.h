@@ -130,6 +130,23 @@ void lua_unref(int32 ref);
 lua_Object lua_createtable();
 int32 lua_collectgarbage(int32 limit);
 
+#define LUA_GC_FULL			0
+#define LUA_GC_INCREMENTAL	1
+
+struct lua_GCStats {
+	int32 cycles;
+	int32 steps;
+	uint32 lastPause;  // in ms
+	uint32 maxPause;
+	uint32 totalPause;
+};
+
+void lua_setgcmode(int32 mode);
+int32 lua_getgcmode();
+void lua_gcstart(); // start an incremental cycle if none is running
+int32 lua_gcstep(int32 work); // returns 1 if the cycle ended
+void lua_getgcstats(lua_GCStats *stats);
+
 void lua_runtasks();
 void current_script();
 
@@ -156,6 +156,8 @@ void luaV_getglobal(TaggedString *ts) {
 	}
 }
 
+// Globals need no write barrier, they are all marked again at the end
+// of an incremental collection
 void luaV_setglobal(TaggedString *ts) {
 	TObject *oldvalue = &ts->globalval;
 	TObject *im = luaT_getimbyObj(oldvalue, IM_SETGLOBAL);
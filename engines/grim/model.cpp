@@ -652,11 +652,7 @@ void ModelNode::draw() const {
 		g_driver->translateViewpoint(_pivot);
 
 		if (!g_driver->isShadowModeActive()) {
-			Sprite *sprite = _sprite;
-			while (sprite) {
-				sprite->draw();
-				sprite = sprite->_next;
-			}
+			Sprite::drawList(_sprite);
 		}
 
 		if (_mesh && _meshVisible) {
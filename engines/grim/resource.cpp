@@ -52,11 +52,19 @@
 #include "common/file.h"
 #include "common/config-manager.h"
 #include "common/translation.h"
+#include "common/system.h"
 
 namespace Grim {
 
 ResourceLoader *g_resourceloader = nullptr;
 
+// Prefetched files which aren't asked for are dropped, oldest first,
+// once they take more memory than this
+static const uint32 kPrefetchMemoryBudget = 32 * 1024 * 1024;
+// Prefetched files are read this many bytes at a time, so the time left
+// can be checked between reads
+static const uint32 kPrefetchChunkSize = 64 * 1024;
+
 class LabListComperator {
 	const Common::String _labName;
 public:
@@ -75,6 +83,14 @@ public:
 ResourceLoader::ResourceLoader() {
 	_cacheDirty = false;
 	_cacheMemorySize = 0;
+	_prefetchMemorySize = 0;
+	_prefetchHits = 0;
+	_prefetchMisses = 0;
+	_prefetchStream = nullptr;
+	_prefetchFile.data = nullptr;
+	_prefetchFile.len = 0;
+	_prefetchPos = 0;
+	memset(_loadStats, 0, sizeof(_loadStats));
 
 	Lab *l;
 	Common::ArchiveMemberList files, updFiles;
@@ -234,6 +250,7 @@ ResourceLoader::~ResourceLoader() {
 		delete[] r.fname;
 		delete[] r.resPtr;
 	}
+	cancelPrefetch();
 	clearList(_models);
 	clearList(_colormaps);
 	clearList(_keyframeAnims);
@@ -284,20 +301,33 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(Common::String fna
 	Common::SeekableReadStream *s;
 	fname.toLowercase();
 
+	unqueuePrefetch(fname);
+
+	uint32 size = 0;
+	byte *buf = takePrefetchedFile(fname, size);
+	if (buf)
+		_prefetchHits++;
+
 	if (cache) {
 		s = getFileFromCache(fname);
 		if (!s) {
-			s = loadFile(fname);
-			if (!s)
-				return nullptr;
-
-			uint32 size = s->size();
-			byte *buf = new byte[size];
-			s->read(buf, size);
+			if (!buf) {
+				s = loadFile(fname);
+				if (!s)
+					return nullptr;
+
+				size = s->size();
+				buf = new byte[size];
+				s->read(buf, size);
+				delete s;
+			}
 			putIntoCache(fname, buf, size);
-			delete s;
 			s = new Common::MemoryReadStream(buf, size);
+		} else {
+			delete[] buf;
 		}
+	} else if (buf) {
+		s = new Common::MemoryReadStream(buf, size, DisposeAfterUse::YES);
 	} else {
 		s = loadFile(fname);
 	}
@@ -316,7 +346,153 @@ void ResourceLoader::putIntoCache(const Common::String &fname, byte *res, uint32
 	_cacheDirty = true;
 }
 
+void ResourceLoader::prefetchFile(const Common::String &filename) {
+	Common::String fname(filename);
+	fname.toLowercase();
+
+	if (_prefetched.contains(fname) || getEntryFromCache(fname))
+		return;
+
+	for (Common::List<Common::String>::const_iterator i = _prefetchQueue.begin(); i != _prefetchQueue.end(); ++i) {
+		if (*i == fname)
+			return;
+	}
+	_prefetchQueue.push_back(fname);
+}
+
+bool ResourceLoader::processPrefetchQueue(uint32 maxMillis) {
+	uint32 startTime = g_system->getMillis();
+
+	while (g_system->getMillis() - startTime < maxMillis) {
+		if (!_prefetchStream) {
+			if (_prefetchQueue.empty())
+				break;
+
+			_prefetchName = _prefetchQueue.front();
+			_prefetchQueue.pop_front();
+			_prefetchStream = loadFile(_prefetchName);
+			if (!_prefetchStream)
+				continue;
+
+			_prefetchFile.len = _prefetchStream->size();
+			_prefetchFile.data = new byte[_prefetchFile.len];
+			_prefetchPos = 0;
+		}
+
+		uint32 chunkSize = MIN(kPrefetchChunkSize, _prefetchFile.len - _prefetchPos);
+		_prefetchStream->read(_prefetchFile.data + _prefetchPos, chunkSize);
+		_prefetchPos += chunkSize;
+		if (_prefetchPos == _prefetchFile.len)
+			finishPrefetch();
+	}
+
+	return _prefetchStream || !_prefetchQueue.empty();
+}
+
+void ResourceLoader::finishPrefetch() {
+	delete _prefetchStream;
+	_prefetchStream = nullptr;
+
+	_prefetched[_prefetchName] = _prefetchFile;
+	_prefetchedOrder.push_back(_prefetchName);
+	_prefetchMemorySize += _prefetchFile.len;
+	_prefetchFile.data = nullptr;
+
+	while (_prefetchMemorySize > kPrefetchMemoryBudget) {
+		uint32 len;
+		delete[] takePrefetchedFile(_prefetchedOrder.front(), len);
+	}
+	Debug::debug(Debug::Engine, "Prefetched %s", _prefetchName.c_str());
+}
+
+void ResourceLoader::abortPrefetch() const {
+	delete _prefetchStream;
+	_prefetchStream = nullptr;
+	delete[] _prefetchFile.data;
+	_prefetchFile.data = nullptr;
+}
+
+void ResourceLoader::cancelPrefetch() {
+	_prefetchQueue.clear();
+	abortPrefetch();
+	while (!_prefetchedOrder.empty()) {
+		uint32 len;
+		delete[] takePrefetchedFile(_prefetchedOrder.front(), len);
+	}
+}
+
+void ResourceLoader::cancelPrefetch(const Common::String &filename) {
+	Common::String fname(filename);
+	fname.toLowercase();
+
+	if (_prefetchStream && _prefetchName == fname)
+		abortPrefetch();
+	_prefetchQueue.remove(fname);
+
+	uint32 len;
+	delete[] takePrefetchedFile(fname, len);
+}
+
+byte *ResourceLoader::takePrefetchedFile(const Common::String &fname, uint32 &len) const {
+	PrefetchMap::iterator it = _prefetched.find(fname);
+	if (it == _prefetched.end())
+		return nullptr;
+
+	byte *data = it->_value.data;
+	len = it->_value.len;
+	_prefetched.erase(it);
+	_prefetchedOrder.remove(fname);
+	_prefetchMemorySize -= len;
+	return data;
+}
+
+void ResourceLoader::unqueuePrefetch(const Common::String &fname) const {
+	if (_prefetchStream && _prefetchName == fname) {
+		// Asked for while it was being read, the rest is read by the caller
+		abortPrefetch();
+		_prefetchMisses++;
+		return;
+	}
+
+	for (Common::List<Common::String>::iterator i = _prefetchQueue.begin(); i != _prefetchQueue.end(); ++i) {
+		if (*i == fname) {
+			// Asked for before the prefetch got to it
+			_prefetchQueue.erase(i);
+			_prefetchMisses++;
+			return;
+		}
+	}
+}
+
+void ResourceLoader::logLoadTime(ResourceType type, const Common::String &fname, uint32 startTime) {
+	uint32 loadTime = g_system->getMillis() - startTime;
+	LoadStats &stats = _loadStats[type];
+	stats.count++;
+	stats.totalTime += loadTime;
+	stats.maxTime = MAX(stats.maxTime, loadTime);
+	Debug::debug(Debug::Engine, "Loaded %s %s in %d ms", getResourceTypeName(type), fname.c_str(), loadTime);
+}
+
+const char *ResourceLoader::getResourceTypeName(ResourceType type) {
+	static const char *const names[kResourceTypeCount] = {
+		"bitmap",
+		"colormap",
+		"costume",
+		"font",
+		"keyframe",
+		"lipsync",
+		"material",
+		"model",
+		"skeleton",
+		"sprite",
+		"animation",
+		"overlay"
+	};
+	return names[type];
+}
+
 CMap *ResourceLoader::loadColormap(const Common::String &filename) {
+	uint32 startTime = g_system->getMillis();
 	Common::SeekableReadStream *stream = openNewStreamFile(filename.c_str());
 	if (!stream) {
 		error("Could not find colormap %s", filename.c_str());
@@ -326,6 +502,7 @@ CMap *ResourceLoader::loadColormap(const Common::String &filename) {
 	_colormaps.push_back(result);
 	delete stream;
 
+	logLoadTime(kResourceColormap, filename, startTime);
 	return result;
 }
 
@@ -346,6 +523,7 @@ Common::String ResourceLoader::fixFilename(const Common::String &filename, bool
 }
 
 Costume *ResourceLoader::loadCostume(const Common::String &filename, Actor *owner, Costume *prevCost) {
+	uint32 startTime = g_system->getMillis();
 	Common::String fname = fixFilename(filename);
 	fname.toLowercase();
 
@@ -362,10 +540,12 @@ Costume *ResourceLoader::loadCostume(const Common::String &filename, Actor *owne
 	result->load(stream);
 	delete stream;
 
+	logLoadTime(kResourceCostume, filename, startTime);
 	return result;
 }
 
 Font *ResourceLoader::loadFont(const Common::String &filename) {
+	uint32 startTime = g_system->getMillis();
 	Common::SeekableReadStream *stream;
 
 	if (g_grim->getGameType() == GType_GRIM && (g_grim->getGameFlags() & ADGF_REMASTERED)) {
@@ -387,6 +567,7 @@ Font *ResourceLoader::loadFont(const Common::String &filename) {
 			stream = openNewStreamFile(font.c_str(), true);
 			FontTTF *result = new FontTTF();
 			result->loadTTF(font, stream, s);
+			logLoadTime(kResourceFont, filename, startTime);
 			return result;
 		}
 	}
@@ -399,10 +580,12 @@ Font *ResourceLoader::loadFont(const Common::String &filename) {
 	result->load(filename, stream);
 	delete stream;
 
+	logLoadTime(kResourceFont, filename, startTime);
 	return result;
 }
 
 KeyframeAnim *ResourceLoader::loadKeyframe(const Common::String &filename) {
+	uint32 startTime = g_system->getMillis();
 	Common::SeekableReadStream *stream;
 
 	stream = openNewStreamFile(filename.c_str());
@@ -413,10 +596,12 @@ KeyframeAnim *ResourceLoader::loadKeyframe(const Common::String &filename) {
 	_keyframeAnims.push_back(result);
 	delete stream;
 
+	logLoadTime(kResourceKeyframe, filename, startTime);
 	return result;
 }
 
 LipSync *ResourceLoader::loadLipSync(const Common::String &filename) {
+	uint32 startTime = g_system->getMillis();
 	LipSync *result;
 	Common::SeekableReadStream *stream;
 
@@ -435,10 +620,12 @@ LipSync *ResourceLoader::loadLipSync(const Common::String &filename) {
 	}
 	delete stream;
 
+	logLoadTime(kResourceLipSync, filename, startTime);
 	return result;
 }
 
 Material *ResourceLoader::loadMaterial(const Common::String &filename, CMap *c, bool clamp) {
+	uint32 startTime = g_system->getMillis();
 	Common::String fname = fixFilename(filename, false);
 	fname.toLowercase();
 	Common::SeekableReadStream *stream;
@@ -459,10 +646,12 @@ Material *ResourceLoader::loadMaterial(const Common::String &filename, CMap *c,
 	Material *result = new Material(fname, stream, c, clamp);
 	delete stream;
 
+	logLoadTime(kResourceMaterial, filename, startTime);
 	return result;
 }
 
 Model *ResourceLoader::loadModel(const Common::String &filename, CMap *c, Model *parent) {
+	uint32 startTime = g_system->getMillis();
 	Common::String fname = fixFilename(filename);
 	Common::SeekableReadStream *stream;
 
@@ -474,10 +663,12 @@ Model *ResourceLoader::loadModel(const Common::String &filename, CMap *c, Model
 	_models.push_back(result);
 	delete stream;
 
+	logLoadTime(kResourceModel, filename, startTime);
 	return result;
 }
 
 EMIModel *ResourceLoader::loadModelEMI(const Common::String &filename, EMICostume *costume) {
+	uint32 startTime = g_system->getMillis();
 	Common::String fname = fixFilename(filename);
 	Common::SeekableReadStream *stream;
 
@@ -491,10 +682,12 @@ EMIModel *ResourceLoader::loadModelEMI(const Common::String &filename, EMICostum
 	_emiModels.push_back(result);
 	delete stream;
 
+	logLoadTime(kResourceModel, filename, startTime);
 	return result;
 }
 
 Skeleton *ResourceLoader::loadSkeleton(const Common::String &filename) {
+	uint32 startTime = g_system->getMillis();
 	Common::String fname = fixFilename(filename);
 	Common::SeekableReadStream *stream;
 
@@ -507,10 +700,12 @@ Skeleton *ResourceLoader::loadSkeleton(const Common::String &filename) {
 	Skeleton *result = new Skeleton(filename, stream);
 	delete stream;
 
+	logLoadTime(kResourceSkeleton, filename, startTime);
 	return result;
 }
 
 Sprite *ResourceLoader::loadSprite(const Common::String &filename, EMICostume *costume) {
+	uint32 startTime = g_system->getMillis();
 	assert(g_grim->getGameType() == GType_MONKEY4);
 	Common::SeekableReadStream *stream;
 
@@ -526,10 +721,12 @@ Sprite *ResourceLoader::loadSprite(const Common::String &filename, EMICostume *c
 	result->loadBinary(stream, costume);
 	delete stream;
 
+	logLoadTime(kResourceSprite, filename, startTime);
 	return result;
 }
 
 AnimationEmi *ResourceLoader::loadAnimationEmi(const Common::String &filename) {
+	uint32 startTime = g_system->getMillis();
 	Common::String fname = fixFilename(filename);
 	Common::SeekableReadStream *stream;
 
@@ -543,10 +740,12 @@ AnimationEmi *ResourceLoader::loadAnimationEmi(const Common::String &filename) {
 	_emiAnims.push_back(result);
 	delete stream;
 
+	logLoadTime(kResourceAnimation, filename, startTime);
 	return result;
 }
 
 Overlay *ResourceLoader::loadOverlay(const Common::String &filename) {
+	uint32 startTime = g_system->getMillis();
 	Common::String fname = fixFilename(filename);
 	Common::SeekableReadStream *stream;
 
@@ -559,6 +758,7 @@ Overlay *ResourceLoader::loadOverlay(const Common::String &filename) {
 	Overlay *result = new Overlay(filename, stream);
 	delete stream;
 
+	logLoadTime(kResourceOverlay, filename, startTime);
 	return result;
 }
 
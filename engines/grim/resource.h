@@ -25,6 +25,8 @@
 
 #include "common/archive.h"
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 
 #include "engines/grim/object.h"
 
@@ -58,6 +60,28 @@ typedef ObjectPtr<AnimationEmi> AnimationEmiPtr;
 
 class ResourceLoader {
 public:
+	enum ResourceType {
+		kResourceBitmap,
+		kResourceColormap,
+		kResourceCostume,
+		kResourceFont,
+		kResourceKeyframe,
+		kResourceLipSync,
+		kResourceMaterial,
+		kResourceModel,
+		kResourceSkeleton,
+		kResourceSprite,
+		kResourceAnimation,
+		kResourceOverlay,
+		kResourceTypeCount
+	};
+
+	struct LoadStats {
+		uint32 count;
+		uint32 totalTime;
+		uint32 maxTime;
+	};
+
 	ResourceLoader();
 	~ResourceLoader();
 
@@ -94,17 +118,76 @@ public:
 
 	static Common::String fixFilename(const Common::String &filename, bool append = true);
 
+	/**
+	 * Queue a file to be read before it is needed. The file is read by
+	 * processPrefetchQueue() and handed over to the first openNewStreamFile()
+	 * call asking for it, so the caller doesn't have to wait for the archive.
+	 *
+	 * @param fname     the name of the file to read
+	 */
+	void prefetchFile(const Common::String &fname);
+	/**
+	 * Read queued files until the queue is empty or maxMillis have elapsed.
+	 * Files are read in small chunks and the time is
+	 * checked before each chunk, so a large file is finished over several
+	 * calls. Nothing is read if maxMillis is 0.
+	 *
+	 * @return  whether files are left in the queue
+	 */
+	bool processPrefetchQueue(uint32 maxMillis);
+	void cancelPrefetch();
+	/**
+	 * Drop a file from the prefetch queue, stopping it if it is being read
+	 * and freeing it if it has been read already.
+	 */
+	void cancelPrefetch(const Common::String &fname);
+	uint32 getPrefetchHits() const { return _prefetchHits; }
+	uint32 getPrefetchMisses() const { return _prefetchMisses; }
+	uint32 getPrefetchMemorySize() const { return _prefetchMemorySize; }
+
+	/**
+	 * Record the time spent loading a resource, started at startTime.
+	 */
+	void logLoadTime(ResourceType type, const Common::String &fname, uint32 startTime);
+	const LoadStats &getLoadStats(ResourceType type) const { return _loadStats[type]; }
+	static const char *getResourceTypeName(ResourceType type);
+
 private:
 	Common::SeekableReadStream *loadFile(const Common::String &filename) const;
 	Common::SeekableReadStream *getFileFromCache(const Common::String &filename) const;
 	ResourceLoader::ResourceCache *getEntryFromCache(const Common::String &filename) const;
 	void putIntoCache(const Common::String &fname, byte *res, uint32 len) const;
 	void uncache(const char *fname) const;
+	byte *takePrefetchedFile(const Common::String &fname, uint32 &len) const;
+	void unqueuePrefetch(const Common::String &fname) const;
+	void finishPrefetch();
+	void abortPrefetch() const;
 
 	mutable Common::Array<ResourceCache> _cache;
 	mutable bool _cacheDirty;
 	mutable int32 _cacheMemorySize;
 
+	struct PrefetchedFile {
+		byte *data;
+		uint32 len;
+	};
+	typedef Common::HashMap<Common::String, PrefetchedFile> PrefetchMap;
+
+	// Read in chunks by processPrefetchQueue() from the main loop
+	mutable Common::List<Common::String> _prefetchQueue;
+	// The file currently being read by processPrefetchQueue(), if any
+	mutable Common::SeekableReadStream *_prefetchStream;
+	mutable Common::String _prefetchName;
+	mutable PrefetchedFile _prefetchFile;
+	mutable uint32 _prefetchPos;
+	mutable PrefetchMap _prefetched;
+	mutable Common::List<Common::String> _prefetchedOrder;
+	mutable uint32 _prefetchMemorySize;
+	mutable uint32 _prefetchHits;
+	mutable uint32 _prefetchMisses;
+
+	LoadStats _loadStats[kResourceTypeCount];
+
 	Common::List<EMIModel *> _emiModels;
 	Common::List<Model *> _models;
 	Common::List<CMap *> _colormaps;
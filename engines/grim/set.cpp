@@ -52,6 +52,7 @@ Set::Set(const Common::String &sceneName, Common::SeekableReadStream *data) :
 		loadBinary(data);
 	}
 	setupOverworldLights();
+	prefetchBitmaps();
 }
 
 Set::Set() :
@@ -65,6 +66,7 @@ Set::Set() :
 
 Set::~Set() {
 	if (_cmaps || g_grim->getGameType() == GType_MONKEY4) {
+		cancelPrefetchBitmaps();
 		delete[] _cmaps;
 		for (int i = 0; i < _numSetups; ++i) {
 			delete _setups[i]._bkgndBm;
@@ -89,6 +91,35 @@ Set::~Set() {
 	}
 }
 
+static void prefetchBitmap(Bitmap *bitmap) {
+	// Bitmaps only read their file the first time they are drawn
+	if (bitmap && !bitmap->getBitmapData()->_loaded)
+		g_resourceloader->prefetchFile(bitmap->getFilename());
+}
+
+void Set::prefetchBitmaps() {
+	for (int i = 0; i < _numSetups; ++i) {
+		prefetchBitmap(_setups[i]._bkgndBm);
+		prefetchBitmap(_setups[i]._bkgndZBm);
+	}
+}
+
+static void cancelPrefetchBitmap(Bitmap *bitmap) {
+	if (bitmap)
+		g_resourceloader->cancelPrefetch(bitmap->getFilename());
+}
+
+void Set::cancelPrefetchBitmaps() {
+	for (int i = 0; i < _numSetups; ++i) {
+		cancelPrefetchBitmap(_setups[i]._bkgndBm);
+		cancelPrefetchBitmap(_setups[i]._bkgndZBm);
+	}
+	foreach (ObjectState *s, _states) {
+		cancelPrefetchBitmap(s->getBitmap());
+		cancelPrefetchBitmap(s->getZBitmap());
+	}
+}
+
 void Set::setupOverworldLights() {
 	Light *l;
 
@@ -1127,6 +1158,8 @@ ObjectState *Set::addObjectState(int setupID, ObjectState::Position pos, const c
 
 	state = new ObjectState(setupID, pos, bitmap, zbitmap, transparency);
 	addObjectState(state);
+	prefetchBitmap(state->getBitmap());
+	prefetchBitmap(state->getZBitmap());
 
 	return state;
 }
@@ -52,6 +52,20 @@ public:
 	void loadText(TextSplitter &ts);
 	void loadBinary(Common::SeekableReadStream *data);
 	void setupOverworldLights();
+	/**
+	 * Queue the backgrounds of all the setups to be read ahead, so
+	 * switching to a setup doesn't wait for its bitmaps to load.
+	 * Object state bitmaps are queued by addObjectState(). Nothing else
+	 * is: the colormaps are read while the set file is parsed, and the
+	 * models, costumes, keyframes and lipsync files used in a set are
+	 * chosen by the scripts when they set up its actors.
+	 */
+	void prefetchBitmaps();
+	/**
+	 * Drop the bitmaps queued by prefetchBitmaps() and addObjectState(),
+	 * so they don't use the prefetch memory once the set is gone.
+	 */
+	void cancelPrefetchBitmaps();
 
 	void saveState(SaveGame *savedState) const;
 	bool restoreState(SaveGame *savedState);
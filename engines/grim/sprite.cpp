@@ -45,6 +45,35 @@ void Sprite::draw() const {
 	g_driver->drawSprite(this);
 }
 
+void Sprite::drawList(const Sprite *sprite) {
+	const int maxBatchSize = 32;
+	const Sprite *batch[maxBatchSize];
+
+	while (sprite) {
+		if (!sprite->_visible) {
+			sprite = sprite->_next;
+			continue;
+		}
+
+		int count = 0;
+		batch[count++] = sprite;
+		const Sprite *next = sprite->_next;
+		while (next && count < maxBatchSize) {
+			if (next->_visible) {
+				if (next->_material != sprite->_material || next->_flags1 != sprite->_flags1 ||
+				    next->_flags2 != sprite->_flags2)
+					break;
+				batch[count++] = next;
+			}
+			next = next->_next;
+		}
+
+		sprite->_material->select();
+		g_driver->drawSprites(batch, count);
+		sprite = next;
+	}
+}
+
 void Sprite::loadGrim(const Common::String &name, const char *comma, CMap *cmap) {
 	int width, height, x, y, z;
 	sscanf(comma, ",%d,%d,%d,%d,%d", &width, &height, &x, &y, &z);
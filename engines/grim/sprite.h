@@ -48,6 +48,12 @@ public:
 
 	Sprite();
 	void draw() const;
+	/**
+	 * Draws a list of sprites linked through _next. Consecutive visible
+	 * sprites which share their material and flags are handed to the
+	 * renderer together.
+	 */
+	static void drawList(const Sprite *sprite);
 	void loadBinary(Common::SeekableReadStream *, EMICostume *costume);
 	void loadGrim(const Common::String &name, const char *comma, CMap *cmap);
 
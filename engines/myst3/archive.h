@@ -88,6 +88,7 @@ public:
 	void close();
 
 	const Common::String &getRoomName() const { return _roomName; }
+	const char *getFileName() const { return _file.getName(); }
 	uint32 getDirectorySize() const { return _directorySize; }
 
 private:
@@ -127,6 +128,8 @@ public:
 	Common::SeekableReadStream *getData() const;
 	uint16 getFace() const { return _subentry->face; }
 	Archive::ResourceType getType() const { return _subentry->type; }
+	uint32 getOffset() const { return _subentry->offset; }
+	const char *getArchiveFileName() const { return _archive->getFileName(); }
 	SpotItemData getSpotItemData() const;
 	VideoData getVideoData() const;
 	uint32 getMiscData(uint index) const;
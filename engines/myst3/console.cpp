@@ -25,6 +25,7 @@
 #include "engines/myst3/archive.h"
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/inventory.h"
 #include "engines/myst3/script.h"
 #include "engines/myst3/state.h"
@@ -44,6 +45,7 @@ Console::Console(Myst3Engine *vm) : GUI::Debugger(), _vm(vm) {
 	registerCmd("fillInventory",			WRAP_METHOD(Console, Cmd_FillInventory));
 	registerCmd("dumpArchive",			WRAP_METHOD(Console, Cmd_DumpArchive));
 	registerCmd("dumpMasks",			WRAP_METHOD(Console, Cmd_DumpMasks));
+	registerCmd("faceCache",			WRAP_METHOD(Console, Cmd_FaceCache));
 }
 
 Console::~Console() {
@@ -327,6 +329,19 @@ bool Console::Cmd_FillInventory(int argc, const char **argv) {
 	return false;
 }
 
+bool Console::Cmd_FaceCache(int argc, const char **argv) {
+	const Image::ImageCache::Stats &stats = _vm->_faceCache->getStats();
+
+	debugPrintf("Hits: %d, misses: %d, prefetched: %d (%d dropped), evictions: %d\n",
+			stats.hits, stats.misses, stats.prefetched, stats.prefetchDropped, stats.evictions);
+	debugPrintf("Decoding time: %d ms\n", stats.decodeTime);
+	debugPrintf("Memory used: %d / %d KB\n",
+			_vm->_faceCache->getMemoryUsed() / 1024, _vm->_faceCache->getMemoryBudget() / 1024);
+	debugPrintf("Last node loaded in %d ms\n", _vm->_lastNodeLoadTime);
+
+	return true;
+}
+
 class DumpingArchiveVisitor : public ArchiveVisitor {
 public:
 	DumpingArchiveVisitor() :
@@ -57,6 +57,7 @@ private:
 	bool Cmd_DumpArchive(int argc, const char **argv);
 	bool Cmd_DumpMasks(int argc, const char **argv);
 	bool Cmd_FillInventory(int argc, const char **argv);
+	bool Cmd_FaceCache(int argc, const char **argv);
 };
 
 } // End of namespace Myst3
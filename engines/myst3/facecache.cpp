@@ -0,0 +1,54 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the AUTHORS
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/myst3/facecache.h"
+#include "engines/myst3/gfx.h"
+
+#include "image/jpeg.h"
+
+namespace Myst3 {
+
+FaceSource::FaceSource(const ResourceDescription &desc) :
+		_desc(desc) {
+}
+
+Common::String FaceSource::getKey() const {
+	// Unlike the description itself, the name of the archive file and the
+	// offset of the resource stay valid when the archive is reopened
+	return Common::String::format("%s:%d", _desc.getArchiveFileName(), _desc.getOffset());
+}
+
+Common::SeekableReadStream *FaceSource::createReadStream() const {
+	return _desc.getData();
+}
+
+Image::ImageCache::Source *FaceSource::clone() const {
+	return new FaceSource(*this);
+}
+
+Image::ImageDecoder *FaceSource::createDecoder() {
+	Image::JPEGDecoder *jpeg = new Image::JPEGDecoder();
+	jpeg->setOutputPixelFormat(Texture::getRGBAPixelFormat());
+	return jpeg;
+}
+
+} // End of namespace Myst3
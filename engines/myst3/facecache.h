@@ -0,0 +1,57 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the AUTHORS
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef MYST3_FACECACHE_H
+#define MYST3_FACECACHE_H
+
+#include "engines/myst3/archive.h"
+
+#include "image/image_cache.h"
+
+namespace Myst3 {
+
+/**
+ * A node face image stored in a Myst 3 archive, to be decoded by Image::ImageCache
+ *
+ * Decoding the JPEG faces is the most expensive part of entering a node.
+ * The faces of the recently visited nodes are kept decoded in the cache,
+ * and the faces of the nodes reachable from the current one are queued
+ * to be decoded while the frames have time to spare.
+ */
+class FaceSource : public Image::ImageCache::Source {
+public:
+	FaceSource(const ResourceDescription &desc);
+
+	Common::String getKey() const override;
+	Common::SeekableReadStream *createReadStream() const override;
+	Image::ImageCache::Source *clone() const override;
+
+	/** Create the decoder for the node faces, producing textures in the RGBA format */
+	static Image::ImageDecoder *createDecoder();
+
+private:
+	ResourceDescription _desc;
+};
+
+} // End of namespace Myst3
+
+#endif // MYST3_FACECACHE_H
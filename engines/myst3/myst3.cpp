@@ -38,6 +38,7 @@
 #include "engines/myst3/console.h"
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/nodeframe.h"
@@ -67,7 +68,7 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		_db(0), _scriptEngine(0),
 		_state(0), _node(0), _scene(0), _archiveNode(0),
 		_cursor(0), _inventory(0), _gfx(0), _menu(0),
-		_rnd(0), _sound(0), _ambient(0),
+		_rnd(0), _sound(0), _ambient(0), _faceCache(0),
 		_inputSpacePressed(false), _inputEnterPressed(false),
 		_inputEscapePressed(false), _inputTildePressed(false),
 		_inputEscapePressedNotConsumed(false),
@@ -75,7 +76,8 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		_menuAction(0), _projectorBackground(0),
 		_shakeEffect(0), _rotationEffect(0),
 		_backgroundSoundScriptLastRoomId(0),
-		_backgroundSoundScriptLastAgeId(0),
+		_backgroundSoundScriptLastAgeId(0), _lastNodeLoadTime(0),
+		_faceCopiesMemory(0),
 		_transition(0), _frameLimiter(0), _inventoryManualHide(false) {
 	DebugMan.addDebugChannel(kDebugVariable, "Variable", "Track Variable Accesses");
 	DebugMan.addDebugChannel(kDebugSaveLoad, "SaveLoad", "Track Save/Load Function");
@@ -126,6 +128,7 @@ Myst3Engine::~Myst3Engine() {
 	delete _rnd;
 	delete _sound;
 	delete _ambient;
+	delete _faceCache;
 	delete _frameLimiter;
 	delete _gfx;
 }
@@ -157,6 +160,7 @@ Common::Error Myst3Engine::run() {
 	_frameLimiter = new FrameLimiter(_system, ConfMan.getInt("engine_speed"));
 	_sound = new Sound(this);
 	_ambient = new Ambient(this);
+	_faceCache = new Image::ImageCache(kFaceCacheBudget);
 	_rnd = new Common::RandomSource("sprint");
 	setDebugger(new Console(this));
 	_scriptEngine = new Script(this);
@@ -217,6 +221,7 @@ Common::Error Myst3Engine::run() {
 
 	unloadNode();
 
+	_faceCache->cancelPrefetch();
 	_archiveNode->close();
 	_gfx->freeFont();
 
@@ -348,6 +353,9 @@ bool Myst3Engine::isTextLanguageEnglish() const {
 }
 
 void Myst3Engine::closeArchives() {
+	if (_faceCache)
+		_faceCache->cancelPrefetch();
+
 	for (uint i = 0; i < _archivesCommon.size(); i++)
 		delete _archivesCommon[i];
 
@@ -755,6 +763,10 @@ void Myst3Engine::drawFrame(bool noSwap) {
 	_gfx->flipBuffer();
 
 	if (!noSwap) {
+		// Decode the faces of the nearby nodes in a fixed slice of each frame.
+		// When the frame limiter is enabled, the slice is taken from its delay.
+		_faceCache->processPrefetchQueue(kFacePrefetchSliceMs);
+
 		_frameLimiter->delayBeforeSwap();
 		_system->updateScreen();
 		_state->updateFrameCounters();
@@ -828,6 +840,8 @@ void Myst3Engine::goToNode(uint16 nodeID, TransitionType transitionType) {
 }
 
 void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
+	uint32 startTime = _system->getMillis();
+
 	unloadNode();
 
 	_scriptEngine->run(&_db->getNodeInitScript());
@@ -852,6 +866,8 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 
 		Common::String nodeFile = Common::String::format("%snodes.m3a", newRoomName.c_str());
 
+		// The queued faces may reference the archive being closed
+		_faceCache->cancelPrefetch();
 		_archiveNode->close();
 		if (!_archiveNode->open(nodeFile.c_str(), newRoomName.c_str())) {
 			error("Unable to open archive %s", nodeFile.c_str());
@@ -873,6 +889,61 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	// Releeshan to the player when he is trapped between both shields.
 	if (nodeID == 9 && roomID == kRoomNarayan)
 		_state->setVar(39, 0);
+
+	_lastNodeLoadTime = _system->getMillis() - startTime;
+	debugC(kDebugNode, "Loaded node %d in %d ms", _state->getLocationNode(), _lastNodeLoadTime);
+
+	prefetchNeighbourNodes();
+}
+
+void Myst3Engine::prefetchNeighbourNodes() {
+	NodePtr nodeData = _db->getNodeData(
+			_state->getLocationNode(),
+			_state->getLocationRoom(),
+			_state->getLocationAge());
+
+	if (!nodeData)
+		return;
+
+	_faceCache->cancelPrefetch();
+
+	// The nodes the player can move to are the destinations of the hotspot scripts.
+	// Only the nodes from the current room are considered, the archives of the
+	// other rooms are not open.
+	for (uint i = 0; i < nodeData->hotspots.size(); i++) {
+		const HotSpot &hotspot = nodeData->hotspots[i];
+
+		for (uint j = 0; j < hotspot.script.size(); j++) {
+			int16 destination = _scriptEngine->getNodeChangeDestination(hotspot.script[j]);
+			if (destination)
+				prefetchNode(_state->valueOrVarValue(destination));
+		}
+	}
+}
+
+void Myst3Engine::prefetchNode(uint16 nodeID) {
+	if (!nodeID || nodeID == _state->getLocationNode())
+		return;
+
+	ResourceDescription jpegDesc = getFileDescription("", nodeID, 1, Archive::kCubeFace);
+	if (jpegDesc.isValid()) {
+		_faceCache->prefetch(FaceSource(jpegDesc), FaceSource::createDecoder);
+
+		for (uint16 face = 2; face <= 6; face++) {
+			jpegDesc = getFileDescription("", nodeID, face, Archive::kCubeFace);
+			if (jpegDesc.isValid())
+				_faceCache->prefetch(FaceSource(jpegDesc), FaceSource::createDecoder);
+		}
+	} else {
+		jpegDesc = NodeFrame::getFrameDescription(this, nodeID);
+		if (jpegDesc.isValid())
+			_faceCache->prefetch(FaceSource(jpegDesc), FaceSource::createDecoder);
+	}
+}
+
+void Myst3Engine::addFaceCopyMemory(int32 size) {
+	_faceCopiesMemory += size;
+	_faceCache->setMemoryBudget(kFaceCacheBudget - MIN<uint32>(_faceCopiesMemory, kFaceCacheBudget / 2));
 }
 
 void Myst3Engine::unloadNode() {
@@ -40,6 +40,10 @@ namespace Common {
 struct Event;
 }
 
+namespace Image {
+class ImageCache;
+}
+
 namespace Myst3 {
 
 // Engine Debug Flags
@@ -50,6 +54,11 @@ enum {
 	kDebugScript   = (1 << 3)
 };
 
+enum {
+	kFaceCacheBudget = 48 * 1024 * 1024, ///< Memory used by the decoded faces, in bytes
+	kFacePrefetchSliceMs = 4             ///< Time spent decoding prefetched faces each frame
+};
+
 enum TransitionType {
 	kTransitionFade = 1,
 	kTransitionNone,
@@ -103,6 +112,7 @@ public:
 	Database *_db;
 	Sound *_sound;
 	Ambient *_ambient;
+	Image::ImageCache *_faceCache;
 	
 	Common::RandomSource *_rnd;
 
@@ -140,6 +150,13 @@ public:
 	void loadNodeCubeFaces(uint16 nodeID);
 	void loadNodeFrame(uint16 nodeID);
 	void loadNodeMenu(uint16 nodeID);
+	void prefetchNode(uint16 nodeID);
+
+	/**
+	 * Count the memory of a face copied out of the face cache against its
+	 * budget, or give it back when the copy is freed
+	 */
+	void addFaceCopyMemory(int32 size);
 
 	void setupTransition();
 	void drawTransition(TransitionType transitionType);
@@ -226,6 +243,12 @@ private:
 	uint32 _backgroundSoundScriptLastRoomId;
 	uint32 _backgroundSoundScriptLastAgeId;
 
+	// Time it took to load the current node, in milliseconds
+	uint32 _lastNodeLoadTime;
+
+	// Memory of the faces copied out of the face cache by the current nodes
+	uint32 _faceCopiesMemory;
+
 	/**
 	 * When the widescreen mode is active, the user can manually hide
 	 * the inventory by clicking on an unused inventory space.
@@ -245,6 +268,8 @@ private:
 
 	bool isInventoryVisible();
 
+	void prefetchNeighbourNodes();
+
 	void interactWithHoveredElement();
 
 	friend class Console;
@@ -22,6 +22,7 @@
 
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/node.h"
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/state.h"
@@ -34,7 +35,14 @@
 namespace Myst3 {
 
 void Face::setTextureFromJPEG(const ResourceDescription *jpegDesc) {
-	_bitmap = Myst3Engine::decodeJpeg(jpegDesc);
+	const Graphics::Surface *face = _vm->_faceCache->getImage(FaceSource(*jpegDesc), FaceSource::createDecoder);
+	if (!face)
+		error("Could not decode Myst III JPEG");
+
+	// The node draws its spot items over the face, it needs its own copy
+	_bitmap = new Graphics::Surface();
+	_bitmap->copyFrom(*face);
+	_vm->addFaceCopyMemory(_bitmap->pitch * _bitmap->h);
 	_texture = _vm->_gfx->createTexture(_bitmap);
 
 	// Set the whole texture as dirty
@@ -71,6 +79,7 @@ void Face::uploadTexture() {
 }
 
 Face::~Face() {
+	_vm->addFaceCopyMemory(-(_bitmap->pitch * _bitmap->h));
 	_bitmap->free();
 	delete _bitmap;
 	_bitmap = 0;
@@ -30,13 +30,7 @@ namespace Myst3 {
 
 NodeFrame::NodeFrame(Myst3Engine *vm, uint16 id) :
 		Node(vm, id) {
-	ResourceDescription jpegDesc = _vm->getFileDescription("", id, 1, Archive::kLocalizedFrame);
-
-	if (!jpegDesc.isValid())
-		jpegDesc = _vm->getFileDescription("", id, 0, Archive::kFrame);
-
-	if (!jpegDesc.isValid())
-		jpegDesc = _vm->getFileDescription("", id, 1, Archive::kFrame);
+	ResourceDescription jpegDesc = getFrameDescription(_vm, id);
 
 	if (!jpegDesc.isValid())
 		error("Frame %d does not exist", id);
@@ -48,6 +42,18 @@ NodeFrame::NodeFrame(Myst3Engine *vm, uint16 id) :
 NodeFrame::~NodeFrame() {
 }
 
+ResourceDescription NodeFrame::getFrameDescription(Myst3Engine *vm, uint16 id) {
+	ResourceDescription jpegDesc = vm->getFileDescription("", id, 1, Archive::kLocalizedFrame);
+
+	if (!jpegDesc.isValid())
+		jpegDesc = vm->getFileDescription("", id, 0, Archive::kFrame);
+
+	if (!jpegDesc.isValid())
+		jpegDesc = vm->getFileDescription("", id, 1, Archive::kFrame);
+
+	return jpegDesc;
+}
+
 void NodeFrame::draw() {
 	Common::Rect screenRect;
 
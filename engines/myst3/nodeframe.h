@@ -34,6 +34,9 @@ public:
 
 	void draw() override;
 
+	/** Find the image of a frame node, the localized one if it exists */
+	static ResourceDescription getFrameDescription(Myst3Engine *vm, uint16 id);
+
 protected:
 	virtual bool isFaceVisible(uint faceId) override { return true; }
 };
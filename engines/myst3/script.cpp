@@ -354,6 +354,16 @@ void Script::runSingleOp(const Opcode &op) {
 	runOp(c, op);
 }
 
+int16 Script::getNodeChangeDestination(const Opcode &opcode) {
+	const Script::Command &cmd = findCommand(opcode.op);
+
+	if (cmd.proc == &Script::goToNodeTransition || cmd.proc == &Script::goToNodeTrans2
+	        || cmd.proc == &Script::goToNodeTrans1 || cmd.proc == &Script::changeNode)
+		return opcode.args.empty() ? 0 : opcode.args[0];
+
+	return 0;
+}
+
 const Common::String Script::describeCommand(uint16 op) {
 	const Script::Command &cmd = findCommand(op);
 
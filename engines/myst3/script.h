@@ -43,6 +43,13 @@ public:
 
 	const Common::String describeOpcode(const Opcode &opcode);
 
+	/**
+	 * Get the node an opcode moves to without leaving the current room
+	 *
+	 * @return the node id, which may be a variable reference, or 0 if the opcode does not change node
+	 */
+	int16 getNodeChangeDestination(const Opcode &opcode);
+
 private:
 	struct Context {
 		bool endScript;
@@ -35,6 +35,7 @@
 #include "sci/engine/gc.h"
 #include "sci/engine/features.h"
 #include "sci/engine/scriptdebug.h"
+#include "sci/engine/script_patches.h"
 #include "sci/sound/midiparser_sci.h"
 #include "sci/sound/music.h"
 #include "sci/sound/drivers/mididriver.h"
@@ -54,9 +55,11 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
+#include "sci/graphics/video32.h"
 #include "sci/sound/decoders/sol.h"
 #include "video/coktel_decoder.h"
 #endif
@@ -100,6 +103,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("selectors",			WRAP_METHOD(Console, cmdSelectors));
 	registerCmd("functions",			WRAP_METHOD(Console, cmdKernelFunctions));
 	registerCmd("class_table",		WRAP_METHOD(Console, cmdClassTable));
+	registerCmd("avoidpath_bench",	WRAP_METHOD(Console, cmdAvoidPathBench));
 	// Parser
 	registerCmd("suffixes",			WRAP_METHOD(Console, cmdSuffixes));
 	registerCmd("parse_grammar",		WRAP_METHOD(Console, cmdParseGrammar));
@@ -115,6 +119,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_id",		WRAP_METHOD(Console, cmdResourceId));
 	registerCmd("resource_info",		WRAP_METHOD(Console, cmdResourceInfo));
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
@@ -150,6 +155,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -163,6 +169,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -176,11 +183,14 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("map_instrument",		WRAP_METHOD(Console, cmdMapInstrument));
 	registerCmd("audio_list",		WRAP_METHOD(Console, cmdAudioList));
 	registerCmd("audio_dump",		WRAP_METHOD(Console, cmdAudioDump));
+	registerCmd("audio_mixer",		WRAP_METHOD(Console, cmdAudioMixer));
+	registerCmd("robot_stats",		WRAP_METHOD(Console, cmdRobotStats));
 	// Script
 	registerCmd("addresses",			WRAP_METHOD(Console, cmdAddresses));
 	registerCmd("registers",			WRAP_METHOD(Console, cmdRegisters));
 	registerCmd("reg",					WRAP_METHOD(Console, cmdRegisters));
 	registerCmd("dissect_script",		WRAP_METHOD(Console, cmdDissectScript));
+	registerCmd("patcher_stats",		WRAP_METHOD(Console, cmdPatcherStats));
 	registerCmd("backtrace",			WRAP_METHOD(Console, cmdBacktrace));
 	registerCmd("bt",					WRAP_METHOD(Console, cmdBacktrace));	// alias
 	registerCmd("trace",				WRAP_METHOD(Console, cmdTrace));
@@ -226,6 +236,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("opcode_stats",		WRAP_METHOD(Console, cmdOpcodeStats));
+	registerCmd("selector_cache",		WRAP_METHOD(Console, cmdSelectorCache));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -257,6 +269,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+	_debugState.profileOpcodes = false;
+	memset(_debugState.opcodeCounts, 0, sizeof(_debugState.opcodeCounts));
 }
 
 Console::~Console() {
@@ -276,6 +290,8 @@ void Console::preEnter() {
 }
 
 extern void playVideo(Video::VideoDecoder &videoDecoder);
+extern const char *opcodeNames[];
+extern void benchmarkAvoidPath(Console *con, int iterations);
 
 void Console::postEnter() {
 	if (!_videoFile.empty()) {
@@ -328,6 +344,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" selector - Attempts to find the requested selector by name\n");
 	debugPrintf(" functions - Lists the kernel functions\n");
 	debugPrintf(" class_table - Shows the available classes\n");
+	debugPrintf(" avoidpath_bench - Times kAvoidPath on a fixed polygon set, with and without its edge index\n");
 	debugPrintf("\n");
 	debugPrintf("Parser:\n");
 	debugPrintf(" suffixes - Lists the vocabulary suffixes\n");
@@ -345,6 +362,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_id - Identifies a resource number by splitting it up in resource type and resource number\n");
 	debugPrintf(" resource_info - Shows info about a resource\n");
 	debugPrintf(" resource_types - Shows the valid resource types\n");
+	debugPrintf(" resource_cache - Shows resource cache usage and statistics, or changes its size\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
@@ -376,6 +394,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" cel_cache - Shows the hit rate of the cel cache and the scale tables (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -388,6 +407,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_stats - Shows garbage collector statistics\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -402,11 +422,14 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" map_instrument - Dynamically maps an MT-32 instrument to a GM instrument\n");
 	debugPrintf(" audio_list - Lists currently active digital audio samples (SCI2+)\n");
 	debugPrintf(" audio_dump - Dumps the requested audio resource as an uncompressed wave file (SCI2+)\n");
+	debugPrintf(" audio_mixer - Shows timing statistics of the digital audio mixer (SCI2+)\n");
+	debugPrintf(" robot_stats - Shows frame decoding statistics of the robot player (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Script:\n");
 	debugPrintf(" addresses - Provides information on how to pass addresses\n");
 	debugPrintf(" registers / reg - Shows the current register values\n");
 	debugPrintf(" dissect_script - Examines a script\n");
+	debugPrintf(" patcher_stats - Shows timing statistics of the script patcher\n");
 	debugPrintf(" backtrace / bt - Dumps the send/self/super/call/calle/callb stack\n");
 	debugPrintf(" trace / t / s - Executes one operation (no parameters) or several operations (specified as a parameter) \n");
 	debugPrintf(" stepover / p - Executes one operation, skips over call/send\n");
@@ -433,6 +456,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" opcode_stats - Counts the executed SCI operations by opcode\n");
+	debugPrintf(" selector_cache - Shows the hit rate of the selector lookup cache\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -1040,6 +1065,39 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdPatcherStats(int argc, const char **argv) {
+	ScriptPatcher *patcher = _engine->getScriptPatcher();
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		patcher->resetStats();
+	} else if (argc != 1) {
+		debugPrintf("Shows timing statistics of the script patcher.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+	} else {
+		patcher->printStats(this);
+	}
+
+	return true;
+}
+
+bool Console::cmdAvoidPathBench(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Times the pathfinding of kAvoidPath on a fixed polygon set, with\n");
+		debugPrintf("and without the edge index, for the given number of iterations.\n");
+		debugPrintf("Usage: %s [<iterations>]\n", argv[0]);
+		return true;
+	}
+
+	int iterations = (argc == 2) ? atoi(argv[1]) : 10;
+	if (iterations <= 0) {
+		debugPrintf("Invalid number of iterations\n");
+		return true;
+	}
+
+	benchmarkAvoidPath(this, iterations);
+	return true;
+}
+
 bool Console::cmdDissectScript(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Examines a script\n");
@@ -1097,6 +1155,37 @@ bool Console::cmdResourceInfo(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		resMan->resetCacheStats();
+		return true;
+	} else if (argc == 3 && !scumm_stricmp(argv[1], "size")) {
+		resMan->setMaxMemoryLRU(MAX(atoi(argv[2]), 0) * 1024);
+	} else if (argc != 1) {
+		debugPrintf("Shows resource cache usage and statistics, or changes the cache size\n");
+		debugPrintf("Usage: %s [reset | size <KiB>]\n", argv[0]);
+		return true;
+	}
+
+	const ResourceManager::CacheStats &stats = resMan->getCacheStats();
+	const uint32 requests = stats.hits + stats.misses;
+
+	debugPrintf("LRU: %u resources, %d of %d KiB, locked: %d KiB\n", resMan->getLRUSize(),
+	            resMan->getMemoryLRU() / 1024, resMan->getMaxMemoryLRU() / 1024, resMan->getMemoryLocked() / 1024);
+	for (int i = 0; i < kResourceTypeInvalid; i++) {
+		const int memory = resMan->getMemoryLRU((ResourceType)i);
+		if (memory)
+			debugPrintf("  %s: %d KiB\n", getResourceTypeName((ResourceType)i), memory / 1024);
+	}
+	debugPrintf("Hits: %u, misses: %u, hit rate: %.1f%%\n", stats.hits, stats.misses,
+	            requests ? stats.hits * 100.0 / requests : 0.0);
+	debugPrintf("Evictions: %u, prefetched: %u, load/decompression time: %u ms\n",
+	            stats.evictions, stats.prefetched, stats.loadTime);
+	return true;
+}
+
 bool Console::cmdResourceTypes(int argc, const char **argv) {
 	debugPrintf("The %d valid resource types are:\n", kResourceTypeInvalid);
 	for (int i = 0; i < kResourceTypeInvalid; i++) {
@@ -1434,6 +1523,51 @@ bool Console::cmdAudioList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdAudioMixer(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_audio32) {
+		debugPrintf("This SCI version does not have a software digital audio mixer\n");
+		return true;
+	}
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		_engine->_audio32->resetMixerStats();
+	} else if (argc != 1) {
+		debugPrintf("Shows timing statistics of the digital audio mixer.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+	} else {
+		_engine->_audio32->printMixerStats(this);
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+
+	return true;
+}
+
+bool Console::cmdRobotStats(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_video32) {
+		debugPrintf("This SCI version does not support robot videos\n");
+		return true;
+	}
+
+	RobotDecoder &robotPlayer = _engine->_video32->getRobotPlayer();
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		robotPlayer.resetDecoderStats();
+	} else if (argc != 1) {
+		debugPrintf("Shows frame decoding statistics of the robot player.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+	} else {
+		robotPlayer.printDecoderStats(this);
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+
+	return true;
+}
+
 bool Console::cmdAudioDump(int argc, const char **argv) {
 #ifdef ENABLE_SCI32
 	if (argc != 2 && argc != 6) {
@@ -2075,6 +2209,37 @@ bool Console::cmdPlaneList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_gfxFrameout) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	}
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		CelObj::resetCacheStats();
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows the hit rate of the cel cache and the scale tables\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const CelCacheStats &stats = CelObj::_cacheStats;
+	const uint32 lookups = stats.hits + stats.misses;
+	const uint32 scalerLookups = stats.scalerTableHits + stats.scalerTableBuilds;
+
+	debugPrintf("Cached cels: %u of %u, evictions: %u\n", CelObj::getCacheSize(), CelObj::getCacheCapacity(), stats.evictions);
+	debugPrintf("Hits: %u, misses: %u, hit rate: %.1f%%\n", stats.hits, stats.misses,
+	            lookups ? stats.hits * 100.0 / lookups : 0.0);
+	debugPrintf("Scale tables: %u hits, %u builds, hit rate: %.1f%%\n", stats.scalerTableHits, stats.scalerTableBuilds,
+	            scalerLookups ? stats.scalerTableHits * 100.0 / scalerLookups : 0.0);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdVisiblePlaneList(int argc, const char **argv) {
 #ifdef ENABLE_SCI32
 	if (_engine->_gfxFrameout) {
@@ -2733,6 +2898,27 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	GCStats &stats = _engine->_gamestate->gcStats;
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		stats.reset();
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows garbage collector statistics.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	debugPrintf("Collections: %u, sweep steps: %u, entries waiting to be freed: %u\n",
+	            stats.cycles, stats.sweepSteps, _engine->_gamestate->gcPendingFrees.size());
+	debugPrintf("Last collection: %u entries scanned, %u unreachable\n", stats.lastScanned, stats.lastGarbage);
+	debugPrintf("Total: %u entries scanned, %u freed\n", stats.totalScanned, stats.totalFreed);
+	debugPrintf("Mark pause (not incremental): last %u us, max %u us\n", stats.lastMarkTime, stats.maxMarkTime);
+	debugPrintf("Sweep pause: last %u us, max %u us\n", stats.lastSweepTime, stats.maxSweepTime);
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
@@ -3268,6 +3454,75 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdOpcodeStats(int argc, const char **argv) {
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "on")) {
+			_debugState.profileOpcodes = true;
+		} else if (!scumm_stricmp(argv[1], "off")) {
+			_debugState.profileOpcodes = false;
+		} else if (!scumm_stricmp(argv[1], "reset")) {
+			memset(_debugState.opcodeCounts, 0, sizeof(_debugState.opcodeCounts));
+		} else {
+			debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	if (argc > 2) {
+		debugPrintf("Counts the executed SCI operations by opcode.\n");
+		debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+		return true;
+	}
+
+	uint32 total = 0;
+	for (uint i = 0; i < ARRAYSIZE(_debugState.opcodeCounts); i++)
+		total += _debugState.opcodeCounts[i];
+
+	debugPrintf("Opcode profiling is %s, %u operations counted\n", _debugState.profileOpcodes ? "on" : "off", total);
+	if (!total)
+		return true;
+
+	// List the opcodes from the most to the least executed one
+	bool listed[ARRAYSIZE(_debugState.opcodeCounts)] = {};
+	for (;;) {
+		int best = -1;
+		for (uint i = 0; i < ARRAYSIZE(_debugState.opcodeCounts); i++) {
+			if (!listed[i] && _debugState.opcodeCounts[i] && (best == -1 || _debugState.opcodeCounts[i] > _debugState.opcodeCounts[best]))
+				best = i;
+		}
+
+		if (best == -1)
+			break;
+
+		listed[best] = true;
+		debugPrintf("%02x %-8s %10u %5.1f%%\n", best, opcodeNames[best], _debugState.opcodeCounts[best],
+		            _debugState.opcodeCounts[best] * 100.0 / total);
+	}
+
+	return true;
+}
+
+bool Console::cmdSelectorCache(int argc, const char **argv) {
+	SelectorLookupCache &cache = _engine->_gamestate->_segMan->getSelectorLookupCache();
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		cache.resetStats();
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Shows the hit rate of the selector lookup cache.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const SelectorLookupCache::Stats &stats = cache.getStats();
+	const uint32 lookups = stats.hits + stats.misses;
+
+	debugPrintf("Cached lookups: %u, flushes: %u\n", cache.size(), stats.flushes);
+	debugPrintf("Hits: %u, misses: %u, hit rate: %.1f%%\n", stats.hits, stats.misses,
+	            lookups ? stats.hits * 100.0 / lookups : 0.0);
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	int curScriptNr = -1;
 
@@ -60,6 +60,7 @@ private:
 	bool cmdSelectors(int argc, const char **argv);
 	bool cmdKernelFunctions(int argc, const char **argv);
 	bool cmdClassTable(int argc, const char **argv);
+	bool cmdAvoidPathBench(int argc, const char **argv);
 	// Parser
 	bool cmdSuffixes(int argc, const char **argv);
 	bool cmdParseGrammar(int argc, const char **argv);
@@ -75,6 +76,7 @@ private:
 	bool cmdHexDump(int argc, const char **argv);
 	bool cmdResourceId(int argc, const char **argv);
 	bool cmdResourceInfo(int argc, const char **argv);
+	bool cmdResourceCache(int argc, const char **argv);
 	bool cmdResourceTypes(int argc, const char **argv);
 	bool cmdList(int argc, const char **argv);
 	bool cmdResourceIntegrityDump(int argc, const char **argv);
@@ -101,6 +103,7 @@ private:
 	bool cmdAnimateList(int argc, const char **argv);
 	bool cmdWindowList(int argc, const char **argv);
 	bool cmdPlaneList(int argc, const char **argv);
+	bool cmdCelCache(int argc, const char **argv);
 	bool cmdVisiblePlaneList(int argc, const char **argv);
 	bool cmdPlaneItemList(int argc, const char **argv);
 	bool cmdVisiblePlaneItemList(int argc, const char **argv);
@@ -116,6 +119,7 @@ private:
 	bool cmdGCShowReachable(int argc, const char **argv);
 	bool cmdGCShowFreeable(int argc, const char **argv);
 	bool cmdGCNormalize(int argc, const char **argv);
+	bool cmdGCStats(int argc, const char **argv);
 	// Music/SFX
 	bool cmdSongLib(int argc, const char **argv);
 	bool cmdSongInfo(int argc, const char **argv);
@@ -128,11 +132,14 @@ private:
 	bool cmdShowInstruments(int argc, const char **argv);
 	bool cmdMapInstrument(int argc, const char **argv);
 	bool cmdAudioList(int argc, const char **argv);
+	bool cmdAudioMixer(int argc, const char **argv);
+	bool cmdRobotStats(int argc, const char **argv);
 	bool cmdAudioDump(int argc, const char **argv);
 	// Script
 	bool cmdAddresses(int argc, const char **argv);
 	bool cmdRegisters(int argc, const char **argv);
 	bool cmdDissectScript(int argc, const char **argv);
+	bool cmdPatcherStats(int argc, const char **argv);
 	bool cmdBacktrace(int argc, const char **argv);
 	bool cmdTrace(int argc, const char **argv);
 	bool cmdStepOver(int argc, const char **argv);
@@ -159,6 +166,8 @@ private:
 	bool cmdBreakpointAddress(int argc, const char **argv);
 	// VM
 	bool cmdScriptSteps(int argc, const char **argv);
+	bool cmdOpcodeStats(int argc, const char **argv);
+	bool cmdSelectorCache(int argc, const char **argv);
 	bool cmdScriptObjects(int argc, const char **argv);
 	bool cmdScriptStrings(int argc, const char **argv);
 	bool cmdScriptSaid(int argc, const char **argv);
@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -179,60 +180,140 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
-	SegManager *segMan = s->_segMan;
+enum {
+	kGCSweepStepMaxFrees = 64, ///< Max. entries freed by a single sweep step
+	kGCSweepStepMaxMillis = 1 ///< Time budget of a single sweep step
+};
 
-	// Some debug stuff
-	debugC(kDebugLevelGC, "[GC] Running...");
+static void freeGarbage(SegManager *segMan, SegmentObj *mobj, reg_t addr) {
 #ifdef GC_DEBUG_CODE
-	const char *segnames[SEG_TYPE_MAX + 1];
-	int segcount[SEG_TYPE_MAX + 1];
-	memset(segnames, 0, sizeof(segnames));
-	memset(segcount, 0, sizeof(segcount));
+	debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x (%s)", PRINT_REG(addr), segmentTypeNames[mobj->getType()]);
+#else
+	debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #endif
+	mobj->freeAtAddress(segMan, addr);
+}
+
+/**
+ * Finds all unreachable entries and queues them in s->gcPendingFrees.
+ * Entries of segments which do not stamp their allocations (i.e. scripts)
+ * can't be checked for reuse later on, so they are freed right away.
+ *
+ * The mark is not split into steps. Between two steps, the VM, the kernel
+ * functions and the engine-side state (ports, planes, lists) could store a
+ * reference to an entry that hasn't been visited yet into one that already
+ * has, and nothing would tell the collector about it, as SCI has no write
+ * barrier on reg_t stores. That entry would then be freed while in use.
+ */
+static void markGarbage(EngineState *s) {
+	SegManager *segMan = s->_segMan;
+	const uint64 startTime = g_system->getMicros();
+
+	debugC(kDebugLevelGC, "[GC] Running...");
 
 	// Compute the set of all segments references currently in use.
 	AddrSet *activeRefs = findAllActiveReferences(s);
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
+	uint32 scanned = 0;
+	uint32 garbage = 0;
 	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
 	for (uint seg = 1; seg < heap.size(); seg++) {
 		SegmentObj *mobj = heap[seg];
 
 		if (mobj != NULL) {
-#ifdef GC_DEBUG_CODE
-			const SegmentType type = mobj->getType();
-			segnames[type] = segmentTypeNames[type];
-#endif
-
 			// Get a list of all deallocatable objects in this segment,
-			// then free any which are not referenced from somewhere.
+			// then queue any which are not referenced from somewhere.
 			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
+			scanned += tmp.size();
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
 				if (!activeRefs->contains(addr)) {
-					// Not found -> we can free it
-					mobj->freeAtAddress(segMan, addr);
-					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
-#ifdef GC_DEBUG_CODE
-					segcount[type]++;
-#endif
+					garbage++;
+
+					GCPendingFree pending;
+					pending.addr = addr;
+					pending.type = mobj->getType();
+					pending.allocationId = mobj->getAllocationId(addr.getOffset());
+					if (pending.allocationId)
+						s->gcPendingFrees.push_back(pending);
+					else
+						freeGarbage(segMan, mobj, addr);
 				}
 			}
-
 		}
 	}
 
 	delete activeRefs;
 
-#ifdef GC_DEBUG_CODE
-	// Output debug summary of garbage collection
-	debugC(kDebugLevelGC, "[GC] Summary:");
-	for (int i = 0; i <= SEG_TYPE_MAX; i++)
-		if (segcount[i])
-			debugC(kDebugLevelGC, "\t%d\t* %s", segcount[i], segnames[i]);
-#endif
+	GCStats &stats = s->gcStats;
+	stats.cycles++;
+	stats.lastScanned = scanned;
+	stats.lastGarbage = garbage;
+	stats.totalScanned += scanned;
+	stats.totalFreed += garbage - s->gcPendingFrees.size();
+	stats.lastMarkTime = (uint32)(g_system->getMicros() - startTime);
+	stats.maxMarkTime = MAX(stats.maxMarkTime, stats.lastMarkTime);
+
+	debugC(kDebugLevelGC, "[GC] Scanned %d entries, %d unreachable, took %d us", scanned, garbage, stats.lastMarkTime);
+}
+
+/**
+ * Frees queued entries, starting with the most recently queued one.
+ * Scripts may have freed an entry themselves since it was marked, and the
+ * slot may even have been handed out again, so entries whose allocation
+ * stamp changed are skipped. Unreachable entries can't become reachable
+ * again, so everything else is still garbage.
+ * @param maxFrees		max. number of entries to free, 0 for no limit
+ * @param maxMillis		time budget, 0 for no limit
+ */
+static void sweepGarbage(EngineState *s, uint maxFrees, uint32 maxMillis) {
+	SegManager *segMan = s->_segMan;
+	const uint64 startTime = g_system->getMicros();
+	uint freed = 0;
+
+	while (!s->gcPendingFrees.empty()) {
+		const GCPendingFree pending = s->gcPendingFrees.back();
+		s->gcPendingFrees.pop_back();
+
+		SegmentObj *mobj = segMan->getSegmentObj(pending.addr.getSegment());
+		if (mobj && mobj->getType() == pending.type &&
+			mobj->isValidOffset(pending.addr.getOffset()) &&
+			mobj->getAllocationId(pending.addr.getOffset()) == pending.allocationId) {
+			freeGarbage(segMan, mobj, pending.addr);
+			s->gcStats.totalFreed++;
+		}
+
+		freed++;
+		if (maxFrees && freed >= maxFrees)
+			break;
+		if (maxMillis && g_system->getMicros() - startTime >= (uint64)maxMillis * 1000)
+			break;
+	}
+
+	GCStats &stats = s->gcStats;
+	stats.sweepSteps++;
+	stats.lastSweepTime = (uint32)(g_system->getMicros() - startTime);
+	stats.maxSweepTime = MAX(stats.maxSweepTime, stats.lastSweepTime);
+}
+
+void run_gc(EngineState *s) {
+	// Finish the sweep of an incremental collection first, so nothing is
+	// queued twice
+	sweepGarbage(s, 0, 0);
+	markGarbage(s);
+	sweepGarbage(s, 0, 0);
+}
+
+void run_gc_mark(EngineState *s) {
+	if (!s->gcPendingFrees.empty())
+		sweepGarbage(s, 0, 0);
+	markGarbage(s);
+}
+
+void run_gc_sweep_step(EngineState *s) {
+	sweepGarbage(s, kGCSweepStepMaxFrees, kGCSweepStepMaxMillis);
 }
 
 } // End of namespace Sci
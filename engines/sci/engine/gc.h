@@ -50,11 +50,28 @@ typedef Common::HashMap<reg_t, bool, reg_t_Hash> AddrSet;
 AddrSet *findAllActiveReferences(EngineState *s);
 
 /**
- * Runs garbage collection on the current system state
+ * Runs garbage collection on the current system state, freeing all
+ * unreachable entries right away
  * @param s The state in which we should gc
  */
 void run_gc(EngineState *s);
 
+/**
+ * Runs the mark phase of the garbage collector. Only the sweep is
+ * incremental: marking still traverses all reachable references in one
+ * pause, as long as a full run_gc does. Unreachable entries are queued in
+ * s->gcPendingFrees and freed by run_gc_sweep_step.
+ * @param s The state in which we should gc
+ */
+void run_gc_mark(EngineState *s);
+
+/**
+ * Frees a part of the entries queued by the last mark phase, within a small
+ * count and time budget
+ * @param s The state in which we should gc
+ */
+void run_gc_sweep_step(EngineState *s);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
@@ -21,6 +21,7 @@
  */
 
 #include "sci/sci.h"
+#include "sci/console.h"
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
 #include "sci/engine/kernel.h"
@@ -35,6 +36,7 @@
 #endif
 
 #include "common/debug-channels.h"
+#include "common/algorithm.h"
 #include "common/list.h"
 #include "common/system.h"
 #include "common/math.h"
@@ -242,11 +244,28 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+// Polygon edge starting at a vertex, with its bounding box
+struct PathfindingEdge {
+	Vertex *vertex;
+	int16 minX, minY, maxX, maxY;
+
+	// Used to sort the edge index by the left side of the bounding boxes
+	bool operator<(const PathfindingEdge &other) const {
+		return minX < other.minX;
+	}
+};
+
+typedef Common::Array<PathfindingEdge> PathfindingEdgeArray;
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
 	PolygonList polygons;
 
+	// All polygon edges, sorted by the left side of their bounding boxes. Used
+	// to only test the edges near a line of sight for intersections.
+	PathfindingEdgeArray edges;
+
 	// Start and end points for pathfinding
 	Vertex *vertex_start, *vertex_end;
 
@@ -263,7 +282,12 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Whether edges outside the bounding box of a line of sight are skipped.
+	// Only cleared by benchmarkAvoidPath() to compare with a full scan.
+	bool useEdgeIndex;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
+		useEdgeIndex = true;
 		vertex_start = NULL;
 		vertex_end = NULL;
 		vertex_index = NULL;
@@ -286,6 +310,7 @@ struct PathfindingState {
 	bool pointOnScreenBorder(const Common::Point &p);
 	bool edgeOnScreenBorder(const Common::Point &p, const Common::Point &q);
 	int findNearPoint(const Common::Point &p, Polygon *polygon, Common::Point *ret);
+	void buildEdgeIndex();
 };
 
 static Common::Point readPoint(SegmentRef list_r, int offset) {
@@ -707,6 +732,7 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	const PathfindingEdgeArray::const_iterator edgesEnd = s->edges.end();
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
@@ -715,32 +741,74 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
 			continue;
 
+		// Edges can only block the line of sight if their bounding box
+		// overlaps the one of the line. between() can't be restricted like
+		// this for a zero-length line, so all edges are checked then.
+		const bool useBounds = s->useEdgeIndex && (vertex_cur->v != vertex->v);
+		const int16 minX = MIN(vertex_cur->v.x, vertex->v.x);
+		const int16 maxX = MAX(vertex_cur->v.x, vertex->v.x);
+		const int16 minY = MIN(vertex_cur->v.y, vertex->v.y);
+		const int16 maxY = MAX(vertex_cur->v.y, vertex->v.y);
+
 		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
+		bool blocked = false;
+		for (PathfindingEdgeArray::const_iterator it = s->edges.begin(); it != edgesEnd; ++it) {
+			if (useBounds) {
+				if (it->minX > maxX)
+					break;
+				if (it->maxX < minX || it->maxY < minY || it->minY > maxY)
 					continue;
-				}
+			}
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+			Vertex *edge = it->vertex;
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge))) {
+					blocked = true;
 					break;
+				}
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v)) {
+				blocked = true;
+				break;
 			}
 		}
 
-		if (j == s->vertices)
+		if (!blocked)
 			visVerts->push_front(vertex);
 	}
 
 	return visVerts;
 }
 
+void PathfindingState::buildEdgeIndex() {
+	edges.clear();
+	edges.reserve(vertices);
+
+	for (int i = 0; i < vertices; i++) {
+		Vertex *vertex = vertex_index[i];
+		if (!VERTEX_HAS_EDGES(vertex))
+			continue;
+
+		const Common::Point &p = vertex->v;
+		const Common::Point &q = CLIST_NEXT(vertex)->v;
+
+		PathfindingEdge edge;
+		edge.vertex = vertex;
+		edge.minX = MIN(p.x, q.x);
+		edge.maxX = MAX(p.x, q.x);
+		edge.minY = MIN(p.y, q.y);
+		edge.maxY = MAX(p.y, q.y);
+		edges.push_back(edge);
+	}
+
+	Common::sort(edges.begin(), edges.end());
+}
+
 /**
  * Determines if a point lies on the screen border
  * Parameters: (const Common::Point &) p: The point
@@ -1344,6 +1412,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	}
 
 	pf_s->vertices = count;
+	pf_s->buildEdgeIndex();
 
 	return pf_s;
 }
@@ -1607,6 +1676,7 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 			}
 		}
 
+		const uint32 startTime = g_system->getMillis();
 		PathfindingState *p = convert_polygon_set(s, poly_list, start, end, width, height, opt);
 
 		if (!p) {
@@ -1628,6 +1698,7 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 		AStar(p);
 
 		output = output_path(p, s);
+		debugC(kDebugLevelAvoidPath, "[avoidpath] %d vertices, %d edges, took %d ms", p->vertices, p->edges.size(), g_system->getMillis() - startTime);
 		delete p;
 
 		// Memory is freed by explicit calls to Memory
@@ -1640,6 +1711,96 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 	}
 }
 
+static PathfindingState *createBenchmarkState(const Common::Point &start, const Common::Point &end) {
+	// A grid of 7x4 octagonal obstacles on a 320x190 screen, with 17 pixel
+	// wide corridors between them
+	static const int16 octagon[][2] = {
+		{ -14, -6 }, { -6, -14 }, { 6, -14 }, { 14, -6 },
+		{ 14, 6 }, { 6, 14 }, { -6, 14 }, { -14, 6 }
+	};
+
+	PathfindingState *s = new PathfindingState(320, 190);
+	int count = 0;
+
+	for (int row = 0; row < 4; row++) {
+		for (int col = 0; col < 7; col++) {
+			Polygon *polygon = new Polygon(POLY_BARRED_ACCESS);
+
+			for (uint i = 0; i < ARRAYSIZE(octagon); i++) {
+				Common::Point p(25 + col * 45 + octagon[i][0], 30 + row * 45 + octagon[i][1]);
+				polygon->vertices.insertHead(new Vertex(p));
+				count++;
+			}
+
+			fix_vertex_order(polygon);
+			s->polygons.push_back(polygon);
+		}
+	}
+
+	s->vertex_start = merge_point(s, start);
+	s->vertex_end = merge_point(s, end);
+
+	s->vertex_index = (Vertex **)malloc(sizeof(Vertex *) * (count + 2));
+	count = 0;
+
+	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
+		Vertex *vertex;
+
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			s->vertex_index[count++] = vertex;
+		}
+	}
+
+	s->vertices = count;
+	s->buildEdgeIndex();
+
+	return s;
+}
+
+void benchmarkAvoidPath(Console *con, int iterations) {
+	// Start and end points in the corridors between the obstacles
+	static const int16 queries[][4] = {
+		{ 2, 7, 317, 187 }, { 317, 7, 2, 187 }, { 47, 187, 272, 7 }, { 2, 97, 317, 97 },
+		{ 137, 7, 182, 187 }, { 92, 52, 227, 142 }, { 2, 142, 317, 52 }, { 272, 187, 47, 7 }
+	};
+
+	uint32 totalTime[2];
+	uint32 pathLength[2];
+	int vertices = 0;
+	int edges = 0;
+
+	for (int mode = 0; mode < 2; mode++) {
+		totalTime[mode] = 0;
+		pathLength[mode] = 0;
+
+		for (int i = 0; i < iterations; i++) {
+			for (uint q = 0; q < ARRAYSIZE(queries); q++) {
+				PathfindingState *s = createBenchmarkState(Common::Point(queries[q][0], queries[q][1]),
+				                                           Common::Point(queries[q][2], queries[q][3]));
+				s->useEdgeIndex = (mode == 0);
+				vertices = s->vertices;
+				edges = s->edges.size();
+
+				const uint32 startTime = g_system->getMicros();
+				AStar(s);
+				totalTime[mode] += g_system->getMicros() - startTime;
+
+				for (Vertex *vertex = s->vertex_end; vertex; vertex = vertex->path_prev)
+					pathLength[mode]++;
+
+				delete s;
+			}
+		}
+	}
+
+	const int runs = iterations * ARRAYSIZE(queries);
+	con->debugPrintf("%d runs of %d vertices and %d edges\n", runs, vertices, edges);
+	con->debugPrintf("Edge index: %u us total, %u us per run\n", totalTime[0], totalTime[0] / runs);
+	con->debugPrintf("Full scan: %u us total, %u us per run\n", totalTime[1], totalTime[1] / runs);
+	if (pathLength[0] != pathLength[1])
+		con->debugPrintf("The paths differ: %u vertices with the edge index, %u without\n", pathLength[0], pathLength[1]);
+}
+
 static bool PointInRect(const Common::Point &point, int16 rectX1, int16 rectY1, int16 rectX2, int16 rectY2) {
 	int16 top = MIN<int16>(rectY1, rectY2);
 	int16 left = MIN<int16>(rectX1, rectX2);
@@ -73,6 +73,36 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	invalidateInstructionCache();
+}
+
+const DecodedInstruction &Script::getInstruction(uint32 offset) {
+	if (_instructionIndex.empty()) {
+		// Only allocated for the scripts which actually get executed
+		_instructionIndex.resize(_buf->size());
+	}
+
+	uint32 index = _instructionIndex[offset];
+	if (!index) {
+		DecodedInstruction instruction;
+		instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, instruction.params);
+		if (_instructions.size() >= 0xFFFF) {
+			_uncachedInstruction = instruction;
+			return _uncachedInstruction;
+		}
+		_instructions.push_back(instruction);
+
+		index = _instructions.size();
+		_instructionIndex[offset] = index;
+	}
+
+	return _instructions[index - 1];
+}
+
+void Script::invalidateInstructionCache() {
+	_instructions.clear();
+	_instructionIndex.clear();
 }
 
 enum {
@@ -147,8 +177,10 @@ void Script::load(int script_nr, ResourceManager *resMan, ScriptPatcher *scriptP
 	}
 
 	// Check scripts (+ possibly SCI 1.1 heap) for matching signatures and patch those, if found
-	if (applyScriptPatches)
+	if (applyScriptPatches) {
 		scriptPatcher->processScript(_nr, outBuffer);
+		invalidateInstructionCache();
+	}
 
 	if (getSciVersion() <= SCI_VERSION_1_LATE) {
 		// Some buggy game scripts contain two export tables (e.g. script 912
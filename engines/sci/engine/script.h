@@ -69,6 +69,15 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+/**
+ * A PMachine instruction, as decoded by readPMachineInstruction
+ */
+struct DecodedInstruction {
+	byte extOpcode;     // "extended" opcode of the instruction
+	uint16 size;        // length in bytes of the instruction
+	int16 params[4];    // parameters of the instruction
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -102,6 +111,18 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * Decoded instructions, indexed by _instructionIndex, which holds for
+	 * each offset of the script buffer the index + 1 of the instruction
+	 * starting there, or 0 if it has not been decoded yet. Scripts before
+	 * SCI3 are limited to 64KB, so they can't have more instructions than a
+	 * uint16 index covers. Instructions past that limit in larger SCI3
+	 * scripts are decoded into _uncachedInstruction on every use.
+	 */
+	Common::Array<DecodedInstruction> _instructions;
+	Common::Array<uint16> _instructionIndex;
+	DecodedInstruction _uncachedInstruction;
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -120,6 +141,21 @@ public:
 	const byte *getBuf(uint offset = 0) const { return _buf->getUnsafeDataAt(offset); }
 	SciSpan<const byte> getSpan(uint offset) const { return _buf->subspan(offset); }
 
+	/**
+	 * Gets the instruction starting at the given offset of the script buffer.
+	 * Instructions are decoded the first time they are executed, and the
+	 * decoded form is reused afterwards.
+	 */
+	const DecodedInstruction &getInstruction(uint32 offset);
+
+	/**
+	 * Drops the decoded instructions. Must be called whenever the code of
+	 * the script is modified.
+	 */
+	void invalidateInstructionCache();
+
+	uint32 getDecodedInstructionCount() const { return _instructions.size(); }
+
 	int getScriptNumber() const { return _nr; }
 	SegmentId getLocalsSegment() const { return _localsSegment; }
 	reg_t *getLocalsBegin() { return _localsBlock ? _localsBlock->_locals.begin() : NULL; }
@@ -21,6 +21,7 @@
  */
 
 #include "sci/sci.h"
+#include "sci/console.h"
 #include "sci/engine/kernel.h"
 #include "sci/engine/script.h"
 #include "sci/engine/state.h"
@@ -30,6 +31,7 @@
 #include "sci/engine/guest_additions.h"
 #endif
 
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Sci {
@@ -20353,6 +20355,7 @@ ScriptPatcher::ScriptPatcher() {
 
 	_runtimeTable = NULL;
 	_isMacSci11 = false;
+	resetStats();
 }
 
 ScriptPatcher::~ScriptPatcher() {
@@ -20361,7 +20364,7 @@ ScriptPatcher::~ScriptPatcher() {
 }
 
 // will actually patch previously found signature area
-void ScriptPatcher::applyPatch(const SciScriptPatcherEntry *patchEntry, SciSpan<byte> scriptData, int32 signatureOffset) {
+uint32 ScriptPatcher::applyPatch(const SciScriptPatcherEntry *patchEntry, SciSpan<byte> scriptData, int32 signatureOffset) {
 	const uint16 *patchData = patchEntry->patchData;
 	byte orgData[PATCH_VALUELIMIT];
 	int32 offset = signatureOffset;
@@ -20469,6 +20472,7 @@ void ScriptPatcher::applyPatch(const SciScriptPatcherEntry *patchEntry, SciSpan<
 		patchData++;
 		patchWord = *patchData;
 	}
+	return offset;
 }
 
 bool ScriptPatcher::verifySignature(uint32 byteOffset, const uint16 *signatureData, const char *signatureDescription, const SciSpan<const byte> &scriptData) {
@@ -20583,8 +20587,62 @@ int32 ScriptPatcher::findSignature(uint32 magicDWord, int magicOffset, const uin
 	return -1;
 }
 
-int32 ScriptPatcher::findSignature(const SciScriptPatcherEntry *patchEntry, const SciScriptPatcherRuntimeEntry *runtimeEntry, const SciSpan<const byte> &scriptData) {
-	return findSignature(runtimeEntry->magicDWord, runtimeEntry->magicOffset, patchEntry->signatureData, patchEntry->description, scriptData);
+void ScriptPatcher::collectSignatureCandidates(const SciScriptPatcherMatcher &matcher, const SciSpan<const byte> &scriptData, uint32 startOffset, uint32 endOffset, Common::Array<Common::Array<uint32> > &candidates) {
+	if (scriptData.size() < 4) // we need to find a DWORD, so less than 4 bytes is not okay
+		return;
+
+	const uint32 searchLimit = MIN<uint32>(endOffset, scriptData.size() - 3);
+	for (uint32 DWordOffset = startOffset; DWordOffset < searchLimit; DWordOffset++) {
+		if (!matcher.firstBytes[scriptData[DWordOffset]])
+			continue;
+
+		Common::HashMap<uint32, SciScriptPatcherEntryList>::const_iterator magicEntries = matcher.magicDWordEntries.find(scriptData.getUint32At(DWordOffset));
+		if (magicEntries == matcher.magicDWordEntries.end())
+			continue;
+
+		const SciScriptPatcherEntryList &entryPositions = magicEntries->_value;
+		for (uint i = 0; i < entryPositions.size(); i++) {
+			const SciScriptPatcherRuntimeEntry &runtimeEntry = _runtimeTable[matcher.entries[entryPositions[i]]];
+			candidates[entryPositions[i]].push_back(DWordOffset + runtimeEntry.magicOffset);
+		}
+	}
+}
+
+void ScriptPatcher::findSignatureCandidates(const SciScriptPatcherMatcher &matcher, const SciSpan<const byte> &scriptData, Common::Array<Common::Array<uint32> > &candidates) {
+	candidates.resize(matcher.entries.size());
+	for (uint i = 0; i < candidates.size(); i++)
+		candidates[i].clear();
+
+	// Offsets are collected in ascending order, so the first verified candidate
+	//  is the same match a linear search for the magic DWORD would have found
+	collectSignatureCandidates(matcher, scriptData, 0, scriptData.size(), candidates);
+}
+
+void ScriptPatcher::updateSignatureCandidates(const SciScriptPatcherMatcher &matcher, const SciSpan<const byte> &scriptData, uint32 patchStart, uint32 patchEnd, Common::Array<Common::Array<uint32> > &candidates) {
+	// Every magic DWORD overlapping the patched bytes may have been created or
+	//  destroyed, which are the ones starting up to 3 bytes before the patch
+	const uint32 rescanStart = patchStart < 3 ? 0 : patchStart - 3;
+	const uint32 rescanEnd = patchEnd;
+
+	Common::Array<Common::Array<uint32> > rescanned;
+	rescanned.resize(matcher.entries.size());
+	collectSignatureCandidates(matcher, scriptData, rescanStart, rescanEnd, rescanned);
+
+	// Replace the candidates of the rescanned range, keeping the lists sorted
+	for (uint entryPos = 0; entryPos < candidates.size(); entryPos++) {
+		Common::Array<uint32> &entryCandidates = candidates[entryPos];
+		const int magicOffset = _runtimeTable[matcher.entries[entryPos]].magicOffset;
+		Common::Array<uint32> merged;
+		uint i = 0;
+		while (i < entryCandidates.size() && entryCandidates[i] - magicOffset < rescanStart)
+			merged.push_back(entryCandidates[i++]);
+		merged.push_back(rescanned[entryPos]);
+		while (i < entryCandidates.size() && entryCandidates[i] - magicOffset < rescanEnd)
+			i++;
+		while (i < entryCandidates.size())
+			merged.push_back(entryCandidates[i++]);
+		entryCandidates = merged;
+	}
 }
 
 // Attention: Magic DWord is returned using platform specific byte order. This is done on purpose for performance.
@@ -20753,6 +20811,28 @@ void ScriptPatcher::initSignature(const SciScriptPatcherEntry *patchTable) {
 	}
 }
 
+// This method groups the active entries of the signature table by script and indexes
+//  them by their magic DWORD, it has to be called after all optional patches got enabled
+void ScriptPatcher::initMatchers(const SciScriptPatcherEntry *patchTable) {
+	const SciScriptPatcherEntry *curEntry = patchTable;
+	const SciScriptPatcherRuntimeEntry *curRuntimeEntry = _runtimeTable;
+	uint entryNr = 0;
+
+	_matchers.clear();
+	while (curEntry->signatureData) {
+		if (curRuntimeEntry->active) {
+			SciScriptPatcherMatcher &matcher = _matchers[curEntry->scriptNr];
+			matcher.magicDWordEntries[curRuntimeEntry->magicDWord].push_back(matcher.entries.size());
+			matcher.entries.push_back(entryNr);
+
+			byte magicBytes[4];
+			WRITE_UINT32(magicBytes, curRuntimeEntry->magicDWord);
+			matcher.firstBytes[magicBytes[0]] = true;
+		}
+		curEntry++; curRuntimeEntry++; entryNr++;
+	}
+}
+
 // This method enables certain patches
 //  It's used for patches, which are not meant to get applied all the time
 void ScriptPatcher::enablePatch(const SciScriptPatcherEntry *patchTable, const char *searchDescription) {
@@ -20777,7 +20857,6 @@ void ScriptPatcher::enablePatch(const SciScriptPatcherEntry *patchTable, const c
 void ScriptPatcher::processScript(uint16 scriptNr, SciSpan<byte> scriptData) {
 	const SciScriptPatcherEntry *signatureTable = NULL;
 	const SciScriptPatcherEntry *curEntry = NULL;
-	SciScriptPatcherRuntimeEntry *curRuntimeEntry = NULL;
 	const Sci::SciGameId gameId = g_sci->getGameId();
 
 	switch (gameId) {
@@ -21063,28 +21142,79 @@ void ScriptPatcher::processScript(uint16 scriptNr, SciSpan<byte> scriptData) {
 			default:
 				break;
 			}
+
+			initMatchers(signatureTable);
 		}
 
-		curEntry = signatureTable;
-		curRuntimeEntry = _runtimeTable;
-
-		while (curEntry->signatureData) {
-			if ((scriptNr == curEntry->scriptNr) && (curRuntimeEntry->active)) {
-				int32 foundOffset = 0;
-				int16 applyCount = curEntry->applyCount;
-				do {
-					foundOffset = findSignature(curEntry, curRuntimeEntry, scriptData);
-					if (foundOffset != -1) {
-						// found, so apply the patch
-						debugC(kDebugLevelPatcher, "Script-Patcher: '%s' on script %d offset %d", curEntry->description, scriptNr, foundOffset);
-						applyPatch(curEntry, scriptData, foundOffset);
+		Common::HashMap<uint16, SciScriptPatcherMatcher>::const_iterator matcherIt = _matchers.find(scriptNr);
+		if (matcherIt == _matchers.end())
+			return;
+
+		const SciScriptPatcherMatcher &matcher = matcherIt->_value;
+		const uint32 startTime = g_system->getMicros();
+		uint verifyCount = 0;
+		uint rescanCount = 0;
+
+		Common::Array<Common::Array<uint32> > candidates;
+		findSignatureCandidates(matcher, scriptData, candidates);
+
+		for (uint entryPos = 0; entryPos < matcher.entries.size(); entryPos++) {
+			curEntry = &signatureTable[matcher.entries[entryPos]];
+			int32 foundOffset = 0;
+			int16 applyCount = curEntry->applyCount;
+			do {
+				foundOffset = -1;
+				const Common::Array<uint32> &entryCandidates = candidates[entryPos];
+				for (uint i = 0; i < entryCandidates.size(); i++) {
+					verifyCount++;
+					if (verifySignature(entryCandidates[i], curEntry->signatureData, curEntry->description, scriptData)) {
+						foundOffset = entryCandidates[i];
+						break;
 					}
-					applyCount--;
-				} while ((foundOffset != -1) && (applyCount));
-			}
-			curEntry++; curRuntimeEntry++;
+				}
+
+				if (foundOffset != -1) {
+					// found, so apply the patch
+					debugC(kDebugLevelPatcher, "Script-Patcher: '%s' on script %d offset %d", curEntry->description, scriptNr, foundOffset);
+					const uint32 patchEnd = applyPatch(curEntry, scriptData, foundOffset);
+					_stats.patchesApplied++;
+
+					// The patch may have created or destroyed magic DWORDs of this
+					//  or later entries, but only around the bytes it has written
+					updateSignatureCandidates(matcher, scriptData, foundOffset, patchEnd, candidates);
+					rescanCount++;
+				}
+				applyCount--;
+			} while ((foundOffset != -1) && (applyCount));
+		}
+
+		const uint32 scanTime = g_system->getMicros() - startTime;
+		_stats.scriptsScanned++;
+		_stats.rangesRescanned += rescanCount;
+		_stats.signaturesVerified += verifyCount;
+		_stats.totalTime += scanTime;
+		if (scanTime > _stats.maxTime) {
+			_stats.maxTime = scanTime;
+			_stats.maxTimeScript = scriptNr;
 		}
+
+		debugC(2, kDebugLevelPatcher, "Script-Patcher: script %d, %u entries, %u ranges rescanned, %u signatures verified in %u us",
+			   scriptNr, matcher.entries.size(), rescanCount, verifyCount, scanTime);
 	}
 }
 
+void ScriptPatcher::printStats(Console *con) const {
+	con->debugPrintf("Scripts scanned: %u, patches applied: %u, ranges rescanned after a patch: %u\n",
+					 _stats.scriptsScanned, _stats.patchesApplied, _stats.rangesRescanned);
+	con->debugPrintf("Signatures verified: %u\n", _stats.signaturesVerified);
+	con->debugPrintf("Scan time: total %.2f ms, avg %.1f us, max %u us (script %d)\n",
+					 _stats.totalTime / 1000.0f,
+					 _stats.scriptsScanned ? (float)_stats.totalTime / _stats.scriptsScanned : 0.0f,
+					 _stats.maxTime, _stats.maxTimeScript);
+}
+
+void ScriptPatcher::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
 } // End of namespace Sci
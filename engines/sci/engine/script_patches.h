@@ -23,10 +23,14 @@
 #ifndef SCI_ENGINE_SCRIPT_PATCHES_H
 #define SCI_ENGINE_SCRIPT_PATCHES_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "sci/sci.h"
 
 namespace Sci {
 
+class Console;
+
 // Please do not use the #defines, that are called SIG_CODE_* / PATCH_CODE_* inside signature/patch-tables
 #define SIG_END                      0xFFFF
 #define SIG_MISMATCH                 0xFFFE
@@ -84,6 +88,41 @@ struct SciScriptPatcherRuntimeEntry {
 	int magicOffset;
 };
 
+typedef Common::Array<uint> SciScriptPatcherEntryList;
+
+/**
+ * The active patch entries of a single script, indexed by their magic DWord,
+ * so that the script data only has to be scanned once for all of them
+ */
+struct SciScriptPatcherMatcher {
+	// Indices of the patch entries in the signature table, in table order
+	SciScriptPatcherEntryList entries;
+	// Positions in `entries` of the patch entries using a given magic DWord
+	Common::HashMap<uint32, SciScriptPatcherEntryList> magicDWordEntries;
+	// Set for every byte a magic DWord of this script starts with
+	bool firstBytes[256];
+
+	SciScriptPatcherMatcher() {
+		memset(firstBytes, 0, sizeof(firstBytes));
+	}
+};
+
+/**
+ * Timing statistics of the script patcher, shown by the `patcher_stats`
+ * debugger command
+ */
+struct ScriptPatcherStats {
+	uint32 scriptsScanned;
+	uint32 patchesApplied;
+	// Number of times candidates were collected again around an applied patch
+	uint32 rangesRescanned;
+	uint32 signaturesVerified;
+	// Times in microseconds
+	uint64 totalTime;
+	uint32 maxTime;
+	uint16 maxTimeScript;
+};
+
 /**
  * ScriptPatcher class, handles on-the-fly patching of script data
  */
@@ -106,6 +145,9 @@ public:
 	// returns -1 in case it was not found or an offset to the matching data
 	int32 findSignature(uint32 magicDWord, int magicOffset, const uint16 *signatureData, const char *patchDescription, const SciSpan<const byte> &scriptData);
 
+	void printStats(Console *con) const;
+	void resetStats();
+
 private:
 	// Initializes a patch table and creates run time information for it (for enabling/disabling), also calculates magic DWORD)
 	void initSignature(const SciScriptPatcherEntry *patchTable);
@@ -113,15 +155,28 @@ private:
 	// Enables a patch inside the patch table (used for optional patches like CD+Text support for KQ6 & LB2)
 	void enablePatch(const SciScriptPatcherEntry *patchTable, const char *searchDescription);
 
-	// Searches for a given signature entry inside script data
-	// returns -1 in case it was not found or an offset to the matching data
-	int32 findSignature(const SciScriptPatcherEntry *patchEntry, const SciScriptPatcherRuntimeEntry *runtimeEntry, const SciSpan<const byte> &scriptData);
+	// Creates the matchers for all scripts which have active patch entries
+	void initMatchers(const SciScriptPatcherEntry *patchTable);
+
+	// Scans script data once for the magic DWords of all patch entries of a matcher
+	//  and collects the offsets, at which the signature of each entry has to be verified
+	void findSignatureCandidates(const SciScriptPatcherMatcher &matcher, const SciSpan<const byte> &scriptData, Common::Array<Common::Array<uint32> > &candidates);
+
+	// Collects the candidates again only for the magic DWords overlapping
+	//  the bytes written by a patch, [patchStart, patchEnd)
+	void updateSignatureCandidates(const SciScriptPatcherMatcher &matcher, const SciSpan<const byte> &scriptData, uint32 patchStart, uint32 patchEnd, Common::Array<Common::Array<uint32> > &candidates);
+
+	// Appends the candidates of the magic DWords starting in [startOffset, endOffset)
+	void collectSignatureCandidates(const SciScriptPatcherMatcher &matcher, const SciSpan<const byte> &scriptData, uint32 startOffset, uint32 endOffset, Common::Array<Common::Array<uint32> > &candidates);
 
 	// Applies a patch to a given script + offset (overwrites parts)
-	void applyPatch(const SciScriptPatcherEntry *patchEntry, SciSpan<byte> scriptData, int32 signatureOffset);
+	// Returns the offset following the last byte written
+	uint32 applyPatch(const SciScriptPatcherEntry *patchEntry, SciSpan<byte> scriptData, int32 signatureOffset);
 
 	Selector *_selectorIdTable;
 	SciScriptPatcherRuntimeEntry *_runtimeTable;
+	Common::HashMap<uint16, SciScriptPatcherMatcher> _matchers;
+	ScriptPatcherStats _stats;
 	bool _isMacSci11;
 };
 
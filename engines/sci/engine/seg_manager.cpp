@@ -22,8 +22,10 @@
 
 #include "sci/sci.h"
 #include "sci/engine/seg_manager.h"
+#include "sci/engine/kernel.h"
 #include "sci/engine/state.h"
 #include "sci/engine/script.h"
+#include "sci/engine/selector.h"
 #ifdef ENABLE_SCI32
 #include "sci/engine/guest_additions.h"
 #endif
@@ -167,6 +169,7 @@ void SegManager::deallocate(SegmentId seg) {
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
+		_selectorLookupCache.clear();
 		if (scr->getLocalsSegment()) {
 			// Check if the locals segment has already been deallocated.
 			// If the locals block has been stored in a segment with an ID
@@ -1042,6 +1045,7 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 		scr = allocateScript(scriptNum, &segmentId);
 	}
 
+	_selectorLookupCache.clear();
 	scr->load(scriptNum, _resMan, _scriptPatcher, applyScriptPatches);
 	scr->initializeLocals(this);
 	scr->initializeClasses(this);
@@ -1050,9 +1054,36 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
 
+	prefetchScriptResources(*scr);
+
 	return segmentId;
 }
 
+void SegManager::prefetchScriptResources(const Script &scr) {
+	// Selectors are not mapped yet while the kernel is being set up
+	if (!g_sci || !g_sci->getKernel())
+		return;
+
+	// The objects of a newly loaded script, usually a room, are initialized
+	// with the views they are going to display. Have the resource manager
+	// load them while the engine is idle, instead of all at once when the
+	// room is drawn for the first time.
+	const Selector viewSelector = SELECTOR(view);
+	if (viewSelector == -1)
+		return;
+
+	const ObjMap &objects = scr.getObjectMap();
+	for (ObjMap::const_iterator it = objects.begin(); it != objects.end(); ++it) {
+		const int index = it->_value.locateVarSelector(this, viewSelector);
+		if (index == -1)
+			continue;
+
+		const reg_t view = it->_value.getVariable(index);
+		if (view.isNumber() && view.toSint16() >= 0)
+			_resMan->prefetchResource(ResourceId(kResourceTypeView, view.toUint16()));
+	}
+}
+
 void SegManager::uninstantiateScript(int script_nr) {
 	SegmentId segmentId = getScriptSegment(script_nr);
 	Script *scr = getScriptIfLoaded(segmentId);
@@ -1080,6 +1111,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		_selectorLookupCache.clear();
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
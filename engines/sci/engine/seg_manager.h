@@ -128,6 +128,12 @@ public:
 private:
 	void uninstantiateScriptSci0(int script_nr);
 
+	/**
+	 * Queues the views referenced by the objects of a newly instantiated
+	 * script for prefetching by the resource manager.
+	 */
+	void prefetchScriptResources(const Script &scr);
+
 public:
 	// TODO: document this
 	reg_t getClassAddress(int classnr, ScriptLoadType lock, uint16 callerSegment, bool applyScriptPatches = true);
@@ -458,9 +464,13 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/** Cache of selector lookups, cleared whenever a script is loaded or unloaded */
+	SelectorLookupCache &getSelectorLookupCache() { return _selectorLookupCache; }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
+	SelectorLookupCache _selectorLookupCache;
 	/** Map script ids to segment ids. */
 	Common::HashMap<int, SegmentId> _scriptSegMap;
 
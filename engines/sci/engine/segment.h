@@ -123,6 +123,15 @@ public:
 	 */
 	virtual void freeAtAddress(SegManager *segMan, reg_t sub_addr) {}
 
+	/**
+	 * Returns a stamp identifying the allocation currently living at the
+	 * given offset, or 0 if the segment does not track allocations.
+	 * Used by the garbage collector to detect entries which were freed and
+	 * reallocated between marking and sweeping.
+	 * @param offset		offset of the entry within this segment
+	 */
+	virtual uint32 getAllocationId(uint32 offset) const { return 0; }
+
 	/**
 	 * Iterates over and reports all addresses within the segment.
 	 * Used by the garbage collector.
@@ -232,17 +241,19 @@ struct SegmentObjTable : public SegmentObj {
 	struct Entry {
 		T *data;
 		int next_free; /* Only used for free entries */
+		uint32 allocationId; /* Stamp of the allocation currently using this entry */
 	};
 	enum { HEAPENTRY_INVALID = -1 };
 
 	int first_free; /**< Beginning of a singly linked list for entries */
 	int entries_used; /**< Statistical information */
+	uint32 _allocationCounter; /**< Source of the allocation stamps */
 
 	typedef Common::Array<Entry> ArrayType;
 	ArrayType _table;
 
 public:
-	SegmentObjTable(SegmentType type) : SegmentObj(type) {
+	SegmentObjTable(SegmentType type) : SegmentObj(type), _allocationCounter(0) {
 		initTable();
 	}
 
@@ -269,12 +280,14 @@ public:
 			_table[oldff].next_free = oldff;
 			assert(_table[oldff].data == nullptr);
 			_table[oldff].data = new T;
+			_table[oldff].allocationId = ++_allocationCounter;
 			return oldff;
 		} else {
 			uint newIdx = _table.size();
 			_table.push_back(Entry());
 			_table.back().data = new T;
 			_table[newIdx].next_free = newIdx;	// Tag as 'valid'
+			_table[newIdx].allocationId = ++_allocationCounter;
 			return newIdx;
 		}
 	}
@@ -287,6 +300,10 @@ public:
 		return idx >= 0 && (uint)idx < _table.size() && _table[idx].next_free == idx;
 	}
 
+	uint32 getAllocationId(uint32 offset) const override {
+		return isValidEntry(offset) ? _table[offset].allocationId : 0;
+	}
+
 	virtual void freeEntry(int idx) {
 		if (idx < 0 || (uint)idx >= _table.size())
 			::error("Table::freeEntry: Attempt to release invalid table index %d", idx);
@@ -341,34 +341,83 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x, %s", PRINT_REG(obj_location), origin.toString().c_str());
 	}
 
-	index = obj->locateVarSelector(segMan, selectorId);
-
-	if (index >= 0) {
-		// Found it as a variable
-		if (varp) {
-			varp->obj = obj_location;
-			varp->varindex = index;
-		}
-		return kSelectorVariable;
-	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
+	SelectorLookupCache &cache = segMan->getSelectorLookupCache();
+	const reg_t pos = obj->getPos();
+	SelectorType type;
+	reg_t function = NULL_REG;
+
+	if (!cache.find(pos, selectorId, type, index, function)) {
+		index = obj->locateVarSelector(segMan, selectorId);
+
+		if (index >= 0) {
+			// Found it as a variable
+			type = kSelectorVariable;
+		} else {
+			// Check if it's a method, with recursive lookup in superclasses
+			type = kSelectorNone;
+			while (obj) {
+				index = obj->funcSelectorPosition(selectorId);
+				if (index >= 0) {
+					function = obj->getFunction(index);
+					type = kSelectorMethod;
+					break;
+				} else {
+					obj = segMan->getObject(obj->getSuperClassSelector());
+				}
 			}
 		}
 
-		return kSelectorNone;
+		cache.store(pos, selectorId, type, index, function);
+	}
+
+	if (type == kSelectorVariable && varp) {
+		varp->obj = obj_location;
+		varp->varindex = index;
+	} else if (type == kSelectorMethod && fptr) {
+		*fptr = function;
 	}
 
+	return type;
+
 
 //	return _lookupSelector_function(segMan, obj, selectorId, fptr);
 }
 
+bool SelectorLookupCache::find(reg_t pos, Selector selectorId, SelectorType &type, int &varIndex, reg_t &function) {
+	Key key;
+	key.pos = pos;
+	key.selectorId = selectorId;
+
+	EntryMap::const_iterator it = _entries.find(key);
+	if (it == _entries.end()) {
+		_stats.misses++;
+		return false;
+	}
+
+	_stats.hits++;
+	type = it->_value.type;
+	varIndex = it->_value.varIndex;
+	function = it->_value.function;
+	return true;
+}
+
+void SelectorLookupCache::store(reg_t pos, Selector selectorId, SelectorType type, int varIndex, reg_t function) {
+	Key key;
+	key.pos = pos;
+	key.selectorId = selectorId;
+
+	Entry &entry = _entries[key];
+	entry.type = type;
+	entry.varIndex = varIndex;
+	entry.function = function;
+}
+
+void SelectorLookupCache::clear() {
+	if (_entries.empty())
+		return;
+
+	_entries.clear();
+	_stats.flushes++;
+}
+
 } // End of namespace Sci
@@ -98,6 +98,35 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * An unreachable table entry found by the garbage collector, waiting to be
+ * freed by one of the following incremental sweep steps.
+ */
+struct GCPendingFree {
+	reg_t addr; //< Address of the entry
+	SegmentType type; //< Type of the segment when the entry was marked
+	uint32 allocationId; //< Allocation stamp of the entry when it was marked
+};
+
+/**
+ * Garbage collector statistics, shown by the gc_stats console command.
+ */
+struct GCStats {
+	uint32 cycles; //< Number of completed mark phases
+	uint32 sweepSteps; //< Number of incremental sweep steps
+	uint32 lastScanned; //< Deallocatable entries looked at by the last mark phase
+	uint32 lastGarbage; //< Unreachable entries found by the last mark phase
+	uint32 totalScanned;
+	uint32 totalFreed;
+	uint32 lastMarkTime; //< Duration of the last mark phase, in us
+	uint32 maxMarkTime;
+	uint32 lastSweepTime; //< Duration of the last sweep step, in us
+	uint32 maxSweepTime;
+
+	GCStats() { reset(); }
+	void reset() { memset(this, 0, sizeof(*this)); }
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -194,6 +223,8 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	Common::Array<GCPendingFree> gcPendingFrees; /**< Garbage left to free by the incremental sweep */
+	GCStats gcStats;
 
 	MessageState *_msgState;
 
@@ -664,13 +664,21 @@ void run_vm(EngineState *s) {
 
 		// Get opcode
 		byte extOpcode;
-		if (!vmHooks.isActive(s))
-			s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
-		else {
+		if (!vmHooks.isActive(s)) {
+			// The parameters are copied, as the instruction may be freed while
+			// it is executed (e.g. when a kernel call unloads its script)
+			const DecodedInstruction &instruction = scr->getInstruction(s->xs->addr.pc.getOffset());
+			extOpcode = instruction.extOpcode;
+			memcpy(opparams, instruction.params, sizeof(opparams));
+			s->xs->addr.pc.incOffset(instruction.size);
+		} else {
 			int offset = readPMachineInstruction(vmHooks.data(), extOpcode, opparams);
 			vmHooks.advance(offset);
 		}
 		const byte opcode = extOpcode >> 1;
+
+		if (g_sci->_debugState.profileOpcodes)
+			g_sci->_debugState.opcodeCounts[opcode]++;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
 #ifdef ABORT_ON_INFINITE_LOOP
@@ -906,10 +914,13 @@ void run_vm(EngineState *s) {
 		}
 
 		case op_callk: { // 0x21 (33)
-			// Run the garbage collector, if needed
-			if (s->gcCountDown-- <= 0) {
+			// Run the garbage collector, if needed. Unreachable entries are
+			// freed a few at a time over the following kernel calls.
+			if (!s->gcPendingFrees.empty()) {
+				run_gc_sweep_step(s);
+			} else if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_gc_mark(s);
 			}
 
 			// Call kernel function
@@ -28,6 +28,7 @@
 #include "sci/engine/vm_types.h"	// for reg_t
 #include "sci/resource/resource.h"	// for SciVersion
 
+#include "common/hashmap.h"
 #include "common/util.h"
 
 namespace Sci {
@@ -401,6 +402,65 @@ void script_debug(EngineState *s);
 SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
 		ObjVarRef *varp, reg_t *fptr);
 
+/**
+ * Cache of the results of lookupSelector.
+ *
+ * An object and its clones share the same position, and with it their
+ * variable layout, methods and superclass chain. The result of a lookup thus
+ * only depends on the position of the object and on the selector, as long as
+ * no script gets loaded or unloaded, which clears the cache.
+ */
+class SelectorLookupCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 flushes;
+
+		Stats() : hits(0), misses(0), flushes(0) {}
+	};
+
+	/**
+	 * Looks up a cached result.
+	 * @return true if the lookup is cached, in which case the result is
+	 *         stored in type, and in varIndex or function depending on it
+	 */
+	bool find(reg_t pos, Selector selectorId, SelectorType &type, int &varIndex, reg_t &function);
+
+	void store(reg_t pos, Selector selectorId, SelectorType type, int varIndex, reg_t function);
+
+	void clear();
+
+	uint size() const { return _entries.size(); }
+	const Stats &getStats() const { return _stats; }
+	void resetStats() { _stats = Stats(); }
+
+private:
+	struct Key {
+		reg_t pos;
+		Selector selectorId;
+
+		bool operator==(const Key &other) const { return pos == other.pos && selectorId == other.selectorId; }
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			return (key.pos.getSegment() << 16) ^ key.pos.getOffset() ^ (key.selectorId * 2654435761U);
+		}
+	};
+
+	struct Entry {
+		SelectorType type;
+		int varIndex;
+		reg_t function;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	EntryMap _entries;
+	Stats _stats;
+};
+
 /**
  * Read a PMachine instruction from a memory buffer and return its length.
  *
@@ -41,15 +41,27 @@ namespace Sci {
 Common::ScopedPtr<CelScaler> CelObj::_scaler;
 
 void CelScaler::activateScaleTables(const Ratio &scaleX, const Ratio &scaleY) {
+	++_useCounter;
+
+	int oldestIndex = -1;
 	for (int i = 0; i < ARRAYSIZE(_scaleTables); ++i) {
 		if (_scaleTables[i].scaleX == scaleX && _scaleTables[i].scaleY == scaleY) {
 			_activeIndex = i;
+			_lastUsed[i] = _useCounter;
+			++CelObj::_cacheStats.scalerTableHits;
 			return;
 		}
+
+		if (i != _activeIndex && (oldestIndex == -1 || _lastUsed[i] < _lastUsed[oldestIndex])) {
+			oldestIndex = i;
+		}
 	}
 
-	const int i = 1 - _activeIndex;
+	++CelObj::_cacheStats.scalerTableBuilds;
+
+	const int i = oldestIndex;
 	_activeIndex = i;
+	_lastUsed[i] = _useCounter;
 	CelScalerTable &table = _scaleTables[i];
 
 	if (table.scaleX != scaleX) {
@@ -91,12 +103,15 @@ void CelObj::init() {
 	_drawBlackLines = false;
 	_nextCacheId = 1;
 	_scaler.reset(new CelScaler());
-	_cache.reset(new CelCache(100));
+	_cache.reset(new CelCache(kCelCacheSize));
+	_cacheIndex.reset(new CelCacheIndex());
+	resetCacheStats();
 }
 
 void CelObj::deinit() {
 	_scaler.reset();
 	_cache.reset();
+	_cacheIndex.reset();
 }
 
 #pragma mark -
@@ -687,9 +702,27 @@ void CelObj::submitPalette() const {
 
 int CelObj::_nextCacheId = 1;
 Common::ScopedPtr<CelCache> CelObj::_cache;
+Common::ScopedPtr<CelCacheIndex> CelObj::_cacheIndex;
+CelCacheStats CelObj::_cacheStats;
+
+void CelObj::resetCacheStats() {
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+}
 
 int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
 	*nextInsertIndex = -1;
+
+	const CelCacheIndex::const_iterator it = _cacheIndex->find(celInfo);
+	if (it != _cacheIndex->end()) {
+		(*_cache)[it->_value].id = ++_nextCacheId;
+		++_cacheStats.hits;
+		return it->_value;
+	}
+
+	++_cacheStats.misses;
+
+	// The cel has to be created from its resource, which is much more
+	// expensive than finding a slot for it
 	int oldestId = _nextCacheId + 1;
 	int oldestIndex = 0;
 
@@ -697,12 +730,8 @@ int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) co
 		CelCacheEntry &entry = (*_cache)[i];
 
 		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
+			*nextInsertIndex = i;
+			return -1;
 		} else if (oldestId > entry.id) {
 			oldestId = entry.id;
 			oldestIndex = i;
@@ -722,8 +751,17 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 	}
 
 	CelCacheEntry &entry = (*_cache)[cacheIndex];
+	if (entry.celObj) {
+		const CelCacheIndex::iterator it = _cacheIndex->find(entry.celObj->_info);
+		if (it != _cacheIndex->end() && it->_value == cacheIndex) {
+			_cacheIndex->erase(it);
+		}
+		++_cacheStats.evictions;
+	}
+
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
+	(*_cacheIndex)[_info] = cacheIndex;
 }
 
 #pragma mark -
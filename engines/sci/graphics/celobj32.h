@@ -23,6 +23,7 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -106,7 +107,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -116,7 +117,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -152,6 +153,37 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+enum {
+	/**
+	 * The number of cel objects kept in the cel cache. SSCI used 100 entries,
+	 * which is too few for scenes with many animated screen items.
+	 */
+	kCelCacheSize = 500
+};
+
+/**
+ * Hashes the fields of a CelInfo32 used by its equivalence criteria.
+ */
+struct CelInfo32Hash {
+	uint operator()(const CelInfo32 &info) const {
+		return (info.type << 28) ^ (info.resourceId << 12) ^ (info.loopNo << 6) ^ info.celNo ^
+			(info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+	}
+};
+
+/**
+ * Maps the CelInfo32 of each cached cel object to its index in the CelCache.
+ */
+typedef Common::HashMap<CelInfo32, int, CelInfo32Hash> CelCacheIndex;
+
+struct CelCacheStats {
+	uint32 hits;
+	uint32 misses;
+	uint32 evictions;
+	uint32 scalerTableHits;
+	uint32 scalerTableBuilds;
+};
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -159,7 +191,14 @@ enum {
 	/**
 	 * The maximum size of a row/column of scaled pixel data.
 	 */
-	kCelScalerTableSize = 4096
+	kCelScalerTableSize = 4096,
+
+	/**
+	 * The number of scale tables kept around. SSCI only kept two, which
+	 * causes the tables to be rebuilt constantly in scenes with several
+	 * screen items drawn at different scales.
+	 */
+	kCelScalerTableCount = 8
 };
 
 struct CelScalerTable {
@@ -192,7 +231,14 @@ class CelScaler {
 	/**
 	 * Cached scale tables.
 	 */
-	CelScalerTable _scaleTables[2];
+	CelScalerTable _scaleTables[kCelScalerTableCount];
+
+	/**
+	 * The value of _useCounter when each scale table was last used, used to
+	 * find the least recently used table.
+	 */
+	uint32 _lastUsed[kCelScalerTableCount];
+	uint32 _useCounter;
 
 	/**
 	 * The index of the most recently used scale table.
@@ -216,6 +262,8 @@ class CelScaler {
 public:
 	CelScaler() :
 		_scaleTables(),
+		_lastUsed(),
+		_useCounter(0),
 		_activeIndex(0) {
 		CelScalerTable &table = _scaleTables[0];
 		table.scaleX = Ratio();
@@ -466,6 +514,22 @@ protected:
 	 */
 	static Common::ScopedPtr<CelCache> _cache;
 
+	/**
+	 * An index of the cel cache, so lookups don't have to scan all of it.
+	 */
+	static Common::ScopedPtr<CelCacheIndex> _cacheIndex;
+
+public:
+	/**
+	 * Hit statistics of the cel cache and of the scale tables.
+	 */
+	static CelCacheStats _cacheStats;
+
+	static void resetCacheStats();
+	static uint getCacheSize() { return _cacheIndex ? _cacheIndex->size() : 0; }
+	static uint getCacheCapacity() { return _cache ? _cache->size() : 0; }
+
+protected:
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
 	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
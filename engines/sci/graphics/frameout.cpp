@@ -488,39 +488,59 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 	screenItemLists.resize(_planes.size());
 	eraseLists.resize(_planes.size());
 
+	// Time spent in each stage of the frame, reported on the graphics debug
+	// channel
+	const uint64 startTime = g_system->getMicros();
+
 	if (g_sci->_gfxRemap32->getRemapCount() > 0 && _remapOccurred) {
 		remapMarkRedraw();
 	}
 
 	calcLists(screenItemLists, eraseLists, eraseRect);
 
+	const uint64 calcTime = g_system->getMicros();
+
 	for (ScreenItemListList::iterator list = screenItemLists.begin(); list != screenItemLists.end(); ++list) {
 		list->sort();
 	}
 
+	uint drawItemCount = 0;
 	for (ScreenItemListList::iterator list = screenItemLists.begin(); list != screenItemLists.end(); ++list) {
 		for (DrawList::iterator drawItem = list->begin(); drawItem != list->end(); ++drawItem) {
 			(*drawItem)->screenItem->getCelObj().submitPalette();
 		}
+		drawItemCount += list->size();
 	}
 
 	_remapOccurred = _palette->updateForFrame();
 
+	const uint64 paletteTime = g_system->getMicros();
+
+	uint eraseRectCount = 0;
 	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
 		drawEraseList(eraseLists[i], *_planes[i]);
 		drawScreenItemList(screenItemLists[i]);
+		eraseRectCount += eraseLists[i].size();
 	}
 
+	const uint64 drawTime = g_system->getMicros();
+
 	if (robotIsActive) {
 		robotPlayer.frameAlmostVisible();
 	}
 
 	_palette->updateHardware();
 
+	const uint showRectCount = _showList.size();
 	if (shouldShowBits) {
 		showBits();
 	}
 
+	const uint64 endTime = g_system->getMicros();
+	debugC(2, kDebugLevelGraphics, "frameOut: %d us (lists %d us, palette %d us, draw %d us, show %d us), %d planes, %d items, %d erase rects, %d show rects",
+		   (int)(endTime - startTime), (int)(calcTime - startTime), (int)(paletteTime - calcTime), (int)(drawTime - paletteTime), (int)(endTime - drawTime),
+		   _planes.size(), drawItemCount, eraseRectCount, showRectCount);
+
 	if (robotIsActive) {
 		robotPlayer.frameNowVisible();
 	}
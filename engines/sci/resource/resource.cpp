@@ -22,9 +22,11 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -992,7 +994,10 @@ void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
+	memset(_memoryLRUByType, 0, sizeof(_memoryLRUByType));
 	_LRU.clear();
+	_prefetchQueue.clear();
+	resetCacheStats();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1066,6 +1071,12 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// The size of the cache can be overridden by the user, in KiB
+	if (!_detectionMode && ConfMan.hasKey("resource_cache_size")) {
+		_maxMemoryLRU = MAX(ConfMan.getInt("resource_cache_size"), 0) * 1024;
+		debugC(1, kDebugLevelResMan, "resMan: Using a %d KiB resource cache", _maxMemoryLRU / 1024);
+	}
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1112,8 +1123,9 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+	_LRU.erase(res->_lruPosition);
 	_memoryLRU -= res->size();
+	_memoryLRUByType[res->getType()] -= res->size();
 	res->_status = kResStatusAllocated;
 }
 
@@ -1123,7 +1135,9 @@ void ResourceManager::addToLRU(Resource *res) {
 		return;
 	}
 	_LRU.push_front(res);
+	res->_lruPosition = _LRU.begin();
 	_memoryLRU += res->size();
+	_memoryLRUByType[res->getType()] += res->size();
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
 	      res->_id.toString().c_str(), res->size,
@@ -1155,6 +1169,7 @@ void ResourceManager::freeOldResources() {
 		Resource *goner = _LRU.back();
 		removeFromLRU(goner);
 		goner->unalloc();
+		_cacheStats.evictions++;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
@@ -1197,9 +1212,16 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		const uint32 startTime = g_system->getMillis();
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+		_cacheStats.loadTime += g_system->getMillis() - startTime;
+		_cacheStats.misses++;
+	} else {
+		_cacheStats.hits++;
+	}
+
+	if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
@@ -1249,6 +1271,55 @@ void ResourceManager::unlockResource(Resource *res) {
 	freeOldResources();
 }
 
+void ResourceManager::prefetchResource(ResourceId id) {
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc)
+		return;
+
+	for (Common::List<ResourceId>::const_iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); ++it) {
+		if (*it == id)
+			return;
+	}
+
+	_prefetchQueue.push_back(id);
+}
+
+uint ResourceManager::processPrefetchQueue(uint32 maxMillis) {
+	const uint32 startTime = g_system->getMillis();
+
+	while (!_prefetchQueue.empty()) {
+		Resource *res = testResource(_prefetchQueue.front());
+		_prefetchQueue.pop_front();
+
+		// The resource may have been requested by the game in the meantime
+		if (res && res->_status == kResStatusNoMalloc) {
+			const uint32 loadStartTime = g_system->getMillis();
+			loadResource(res);
+			_cacheStats.loadTime += g_system->getMillis() - loadStartTime;
+
+			if (res->_status == kResStatusAllocated && res->data()) {
+				addToLRU(res);
+				freeOldResources();
+				_cacheStats.prefetched++;
+			}
+		}
+
+		if (g_system->getMillis() - startTime >= maxMillis)
+			break;
+	}
+
+	return _prefetchQueue.size();
+}
+
+void ResourceManager::resetCacheStats() {
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+}
+
+void ResourceManager::setMaxMemoryLRU(int maxMemory) {
+	_maxMemoryLRU = maxMemory;
+	freeOldResources();
+}
+
 const char *ResourceManager::versionDescription(ResVersion version) const {
 	switch (version) {
 	case kResVersionUnknown:
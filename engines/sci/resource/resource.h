@@ -298,6 +298,7 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	Common::List<Resource *>::iterator _lruPosition; /**< Position in the LRU list, only valid while enqueued */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -369,6 +370,48 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	/**
+	 * Queues a resource to be loaded ahead of time by processPrefetchQueue.
+	 * Resources which don't exist or are already loaded are ignored.
+	 * @param id	Id of the resource to load
+	 */
+	void prefetchResource(ResourceId id);
+
+	/**
+	 * Loads queued resources into the LRU cache until the queue is empty
+	 * or the time budget is spent.
+	 * @param maxMillis	Time budget, at least one resource is loaded
+	 * @return			The number of resources still queued
+	 */
+	uint processPrefetchQueue(uint32 maxMillis);
+
+	/**
+	 * Drops all queued prefetch requests.
+	 */
+	void cancelPrefetch() { _prefetchQueue.clear(); }
+
+	struct CacheStats {
+		uint32 hits; ///< Requests for resources which were in memory
+		uint32 misses; ///< Requests for resources which had to be loaded
+		uint32 evictions; ///< Resources freed to stay within the LRU budget
+		uint32 prefetched; ///< Resources loaded by processPrefetchQueue
+		uint32 loadTime; ///< Total time spent reading and decompressing resources, in ms
+	};
+
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats();
+
+	/**
+	 * Changes the amount of memory used for unlocked resources. Resources are
+	 * freed right away if needed.
+	 */
+	void setMaxMemoryLRU(int maxMemory);
+	int getMaxMemoryLRU() const { return _maxMemoryLRU; }
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMemoryLRU(ResourceType type) const { return _memoryLRUByType[type]; }
+	int getMemoryLocked() const { return _memoryLocked; }
+	uint getLRUSize() const { return _LRU.size(); }
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -489,7 +532,10 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
+	int _memoryLRUByType[kResourceTypeInvalid]; ///< _memoryLRU, split by resource type
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Common::List<ResourceId> _prefetchQueue; ///< Resources to load ahead of time
+	CacheStats _cacheStats;
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -916,6 +916,15 @@ void SciEngine::sleep(uint32 msecs) {
 #endif
 		time = g_system->getMillis();
 		if (time + 10 < wakeUpTime) {
+#ifdef ENABLE_SCI32
+			// Read and decompress upcoming robot frames while waiting for the
+			// next one to be due
+			if (_video32 && _video32->getRobotPlayer().readAhead())
+				continue;
+#endif
+			// Use the time to load resources the game is going to need
+			if (_resMan->processPrefetchQueue(wakeUpTime - time - 10) || g_system->getMillis() + 10 >= wakeUpTime)
+				continue;
 			g_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
@@ -212,6 +212,8 @@ Audio32::Audio32(ResourceManager *resMan) :
 
 	_monitoredChannelIndex(-1),
 	_numMonitoredSamples(0) {
+	resetMixerStats();
+
 	// In games where scripts premultiply master audio volumes into the volumes
 	// of the individual audio channels sent to the mixer, Audio32 needs to use
 	// the kPlainSoundType so that the master SFX volume is not applied twice.
@@ -297,6 +299,8 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 		return 0;
 	}
 
+	const uint64 startTime = g_system->getMicros();
+
 	// ResourceManager is not thread-safe so we need to avoid calling into it
 	// from the audio thread, but at the same time we need to be able to clear
 	// out any finished channels on a regular basis
@@ -343,6 +347,7 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 
 	int maxSamplesWritten = 0;
 	bool firstChannelWritten = false;
+	bool robotUnderrun = false;
 
 	for (int16 channelIndex = 0; channelIndex < _numActiveChannels; ++channelIndex) {
 		const AudioChannel &channel = getChannel(channelIndex);
@@ -356,6 +361,16 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 			continue;
 		}
 
+		if (channel.robot) {
+			// The audio buffered ahead of the read head is how far the robot
+			// decoder is ahead of playback
+			const int bufferedSamples = static_cast<RobotAudioStream *>(channel.stream.get())->getNumBufferedSamples();
+			_mixerStats.robotBufferedSamples = bufferedSamples;
+			if (_mixerStats.minRobotBufferedSamples == -1 || bufferedSamples < _mixerStats.minRobotBufferedSamples) {
+				_mixerStats.minRobotBufferedSamples = bufferedSamples;
+			}
+		}
+
 		// Channel finished fading and had the stopChannelOnFade flag set, so no
 		// longer exists
 		if (channel.fadeStartTick && processFade(channelIndex)) {
@@ -414,7 +429,9 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 			if (numSamples > (int)_monitoredBuffer.size()) {
 				_monitoredBuffer.resize(numSamples);
 			}
-			memset(_monitoredBuffer.data(), 0, _monitoredBuffer.size() * sizeof(Audio::st_sample_t));
+			// Only the part written by this callback needs to be cleared, the
+			// buffer keeps the size of the largest callback
+			memset(_monitoredBuffer.data(), 0, numSamples * sizeof(Audio::st_sample_t));
 			_numMonitoredSamples = writeAudioInternal(*channel.stream, *channel.converter, _monitoredBuffer.data(), numSamples, leftVolume, rightVolume);
 
 			Audio::st_sample_t *sourceBuffer = _monitoredBuffer.data();
@@ -442,11 +459,24 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 			if (channelSamplesWritten > maxSamplesWritten) {
 				maxSamplesWritten = channelSamplesWritten;
 			}
+
+			if (channel.robot && channelSamplesWritten < numSamples && !channel.stream->endOfStream()) {
+				robotUnderrun = true;
+			}
 		}
 	}
 
 	_inAudioThread = false;
 
+	const uint32 callbackTime = g_system->getMicros() - startTime;
+	++_mixerStats.callbacks;
+	_mixerStats.totalCallbackTime += callbackTime;
+	_mixerStats.maxCallbackTime = MAX(_mixerStats.maxCallbackTime, callbackTime);
+	_mixerStats.lastCallbackSamples = numSamples;
+	if (robotUnderrun) {
+		++_mixerStats.robotUnderruns;
+	}
+
 	return maxSamplesWritten;
 }
 
@@ -1391,6 +1421,35 @@ void Audio32::kernelPanOff(EngineState *s, const int argc, const reg_t *const ar
 #pragma mark -
 #pragma mark Debugging
 
+void Audio32::printMixerStats(Console *con) const {
+	Common::StackLock lock(_mutex);
+	const MixerStats &stats = _mixerStats;
+
+	// Samples are interleaved stereo pairs at the output rate of the mixer
+	const uint outputRate = _mixer->getOutputRate();
+	con->debugPrintf("Mixer callbacks: %u, avg %.1f us, max %u us\n",
+					 stats.callbacks,
+					 stats.callbacks ? (float)stats.totalCallbackTime / stats.callbacks : 0.0f,
+					 stats.maxCallbackTime);
+	con->debugPrintf("Output buffer: %d samples (%.1f ms of audio)\n",
+					 stats.lastCallbackSamples,
+					 outputRate ? stats.lastCallbackSamples / 2 * 1000.0f / outputRate : 0.0f);
+
+	// Robot audio is mono
+	if (stats.minRobotBufferedSamples != -1) {
+		con->debugPrintf("Robot audio buffered: %.1f ms (min %.1f ms)\n",
+						 stats.robotBufferedSamples * 1000.0f / RobotAudioStream::kRobotSampleRate,
+						 stats.minRobotBufferedSamples * 1000.0f / RobotAudioStream::kRobotSampleRate);
+	}
+	con->debugPrintf("Robot audio underruns: %u\n", stats.robotUnderruns);
+}
+
+void Audio32::resetMixerStats() {
+	Common::StackLock lock(_mutex);
+	memset(&_mixerStats, 0, sizeof(_mixerStats));
+	_mixerStats.minRobotBufferedSamples = -1;
+}
+
 void Audio32::printAudioList(Console *con) const {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i < _numActiveChannels; ++i) {
@@ -191,6 +191,8 @@ private:
 	ResourceManager *_resMan;
 	Audio::Mixer *_mixer;
 	Audio::SoundHandle _handle;
+
+	// Guards the channels against the mixer callback
 	Common::Mutex _mutex;
 
 #pragma mark -
@@ -653,6 +655,26 @@ public:
 #pragma mark Debugging
 public:
 	void printAudioList(Console *con) const;
+	void printMixerStats(Console *con) const;
+	void resetMixerStats();
+
+private:
+	/**
+	 * Statistics about the mixer callback. The mutex is held for the whole
+	 * callback, so its duration is also the longest time the engine can be
+	 * kept waiting when it changes the state of a channel.
+	 */
+	struct MixerStats {
+		uint32 callbacks;
+		uint64 totalCallbackTime; ///< us
+		uint32 maxCallbackTime; ///< us
+		int lastCallbackSamples; ///< Number of samples requested by the last callback
+		uint32 robotUnderruns; ///< Callbacks where a robot stream had fewer samples ready than requested
+		int robotBufferedSamples; ///< Robot audio samples ready for playback at the last callback
+		int minRobotBufferedSamples; ///< Fewest robot audio samples ready at any callback, or -1
+	};
+
+	MixerStats _mixerStats;
 };
 
 } // End of namespace Sci
@@ -30,8 +30,10 @@
 #include "common/str.h"              // for String
 #include "common/stream.h"           // for SeekableReadStream
 #include "common/substream.h"        // for SeekableSubReadStreamEndian
+#include "common/system.h"           // for g_system
 #include "common/textconsole.h"      // for error, warning
 #include "common/types.h"            // for Flag::NO, Flag::YES
+#include "sci/console.h"             // for Console
 #include "sci/engine/seg_manager.h"  // for SegManager
 #include "sci/graphics/celobj32.h"   // for Ratio, ::kLowResX, ::kLowResY
 #include "sci/graphics/text32.h"     // for BitmapResource
@@ -297,6 +299,15 @@ RobotAudioStream::StreamState RobotAudioStream::getStatus() const {
 	return status;
 }
 
+int RobotAudioStream::getNumBufferedSamples() const {
+	Common::StackLock lock(_mutex);
+	if (_waiting) {
+		return 0;
+	}
+
+	return (_writeHeadAbs - _readHeadAbs) / sizeof(Audio::st_sample_t);
+}
+
 int RobotAudioStream::readBuffer(Audio::st_sample_t *outBuffer, int numSamples) {
 	Common::StackLock lock(_mutex);
 
@@ -351,7 +362,9 @@ RobotDecoder::RobotDecoder(SegManager *segMan) :
 	_segMan(segMan),
 	_status(kRobotStatusUninitialized),
 	_audioBuffer(nullptr),
-	_rawPalette((uint8 *)malloc(kRawPaletteSize)) {}
+	_rawPalette((uint8 *)malloc(kRawPaletteSize)) {
+	resetDecoderStats();
+}
 
 RobotDecoder::~RobotDecoder() {
 	close();
@@ -542,6 +555,7 @@ void RobotDecoder::open(const GuiResourceId robotId, const reg_t plane, const in
 
 	debugC(kDebugLevelVideo, "Opening version %d robot %d", _version, robotId);
 
+	resetDecoderStats();
 	initPlayback();
 
 	_syncFrame = true;
@@ -619,6 +633,7 @@ void RobotDecoder::close() {
 	_recordPositions.clear();
 	_celDecompressionBuffer.clear();
 	_doVersion5Scratch.clear();
+	clearReadAhead();
 	delete _stream;
 	_stream = nullptr;
 }
@@ -792,6 +807,155 @@ RobotDecoder::RobotStatus RobotDecoder::getStatus() const {
 	return _status;
 }
 
+bool RobotDecoder::readAhead() {
+	if (_status != kRobotStatusPlaying) {
+		return false;
+	}
+
+	const int lastFrameNo = MIN<int>(_currentFrameNo + kReadAheadFrameCount, _numFramesTotal - 1);
+	for (int frameNo = _currentFrameNo + 1; frameNo <= lastFrameNo; ++frameNo) {
+		ReadAheadFrame *freeSlot = nullptr;
+		ReadAheadFrame *frame = nullptr;
+		for (int i = 0; i < kReadAheadFrameCount; ++i) {
+			ReadAheadFrame &slot = _readAheadFrames[i];
+			if (slot.frameNo == frameNo) {
+				frame = &slot;
+				break;
+			}
+
+			// Records of frames which have already been shown or skipped
+			// are never going to be used
+			if (slot.frameNo <= _currentFrameNo && freeSlot == nullptr) {
+				freeSlot = &slot;
+			}
+		}
+
+		// Each call does one step of work so that the caller can check how
+		// much idle time is left in between. The nearest frame is finished
+		// before the record of a later one is read.
+		if (frame != nullptr) {
+			if (!frame->isDecompressed) {
+				decompressReadAheadFrame(*frame);
+				return true;
+			}
+			continue;
+		}
+
+		if (freeSlot == nullptr) {
+			return false;
+		}
+
+		// doRobot and showFrame always seek to the record they need, but
+		// the stream position is restored anyway so reading ahead has no
+		// observable effect on playback
+		const int32 oldPosition = _stream->pos();
+		const int videoSize = _videoSizes[frameNo];
+		freeSlot->data.resize(videoSize);
+		freeSlot->pixels.clear();
+		freeSlot->isDecompressed = false;
+		_stream->seek(_recordPositions[frameNo], SEEK_SET);
+		if (_stream->read(freeSlot->data.begin(), videoSize) == (uint32)videoSize) {
+			freeSlot->frameNo = frameNo;
+		} else {
+			freeSlot->frameNo = -1;
+		}
+		_stream->seek(oldPosition, SEEK_SET);
+		return true;
+	}
+
+	return false;
+}
+
+void RobotDecoder::decompressReadAheadFrame(ReadAheadFrame &frame) {
+	// Cels are decompressed from the record alone, without touching any
+	// playback state, so this can happen at any time before the frame is
+	// shown. The cel bitmaps themselves are only written by doRobot, since
+	// the ones of the current frame are still on screen until then.
+	frame.isDecompressed = true;
+	frame.pixels.clear();
+
+	const byte *rawVideoData = frame.data.begin();
+	const int16 numCels = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData);
+	if (numCels > kScreenItemListSize) {
+		return;
+	}
+	rawVideoData += 2;
+
+	// The decompressed sizes are validated up front so that a bad record
+	// just falls back to decompressing during doRobot, which reports it
+	uint totalArea = 0;
+	const byte *celData = rawVideoData;
+	for (int16 i = 0; i < numCels; ++i) {
+		const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(celData + 2);
+		const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(celData + 4);
+		const uint8 verticalScaleFactor = celData[1];
+		const uint16 dataSize = READ_SCI11ENDIAN_UINT16(celData + 14);
+		const int16 numDataChunks = (int16)READ_SCI11ENDIAN_UINT16(celData + 16);
+
+		uint decompressedSize = 0;
+		const byte *chunk = celData + kCelHeaderSize;
+		for (int16 j = 0; j < numDataChunks; ++j) {
+			decompressedSize += READ_SCI11ENDIAN_UINT32(chunk + 4);
+			chunk += 10 + READ_SCI11ENDIAN_UINT32(chunk);
+		}
+
+		const int squashedHeight = celHeight * verticalScaleFactor / 100;
+		if (celWidth <= 0 || squashedHeight <= 0 || decompressedSize != (uint)(celWidth * squashedHeight)) {
+			return;
+		}
+
+		totalArea += celWidth * celHeight;
+		celData += kCelHeaderSize + dataSize;
+	}
+
+	frame.pixels.resize(totalArea);
+	byte *target = frame.pixels.begin();
+	celData = rawVideoData;
+	for (int16 i = 0; i < numCels; ++i) {
+		const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(celData + 2);
+		const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(celData + 4);
+		const uint8 verticalScaleFactor = celData[1];
+		const uint16 dataSize = READ_SCI11ENDIAN_UINT16(celData + 14);
+		const int16 numDataChunks = (int16)READ_SCI11ENDIAN_UINT16(celData + 16);
+
+		if (verticalScaleFactor == 100) {
+			decompressCelChunks(target, celData + kCelHeaderSize, numDataChunks);
+		} else {
+			_readAheadSquashedCel.resize(celWidth * (celHeight * verticalScaleFactor / 100));
+			decompressCelChunks(_readAheadSquashedCel.begin(), celData + kCelHeaderSize, numDataChunks);
+			expandCel(target, _readAheadSquashedCel.begin(), celWidth, celHeight, verticalScaleFactor);
+		}
+
+		target += celWidth * celHeight;
+		celData += kCelHeaderSize + dataSize;
+	}
+}
+
+void RobotDecoder::clearReadAhead() {
+	for (int i = 0; i < kReadAheadFrameCount; ++i) {
+		_readAheadFrames[i].frameNo = -1;
+		_readAheadFrames[i].data.clear();
+		_readAheadFrames[i].pixels.clear();
+		_readAheadFrames[i].isDecompressed = false;
+	}
+	_readAheadSquashedCel.clear();
+}
+
+void RobotDecoder::printDecoderStats(Console *con) const {
+	const DecoderStats &stats = _decoderStats;
+	con->debugPrintf("Frames decoded: %u, avg %.2f ms, max %.2f ms, last %.2f ms\n",
+					 stats.framesDecoded,
+					 stats.framesDecoded ? stats.totalDecodeTime / 1000.0f / stats.framesDecoded : 0.0f,
+					 stats.maxDecodeTime / 1000.0f, stats.lastDecodeTime / 1000.0f);
+	con->debugPrintf("Late frames: %u (%u frames skipped)\n", stats.lateFrames, stats.framesSkipped);
+	con->debugPrintf("Read-ahead: %u hits (%u with cels already decompressed), %u misses\n",
+					 stats.readAheadHits, stats.decompressedAheadHits, stats.readAheadMisses);
+}
+
+void RobotDecoder::resetDecoderStats() {
+	memset(&_decoderStats, 0, sizeof(_decoderStats));
+}
+
 bool RobotDecoder::seekToFrame(const int frameNo) {
 	return _stream->seek(_recordPositions[frameNo], SEEK_SET);
 }
@@ -1205,6 +1369,10 @@ void RobotDecoder::doRobot() {
 			if (nextFrameNo < _currentFrameNo) {
 				return;
 			}
+			if (_previousFrameNo != -1 && nextFrameNo > _previousFrameNo + 1) {
+				++_decoderStats.lateFrames;
+				_decoderStats.framesSkipped += nextFrameNo - _previousFrameNo - 1;
+			}
 			_currentFrameNo = nextFrameNo;
 		}
 	}
@@ -1331,10 +1499,10 @@ void RobotDecoder::frameNowVisible() {
 	}
 }
 
-void RobotDecoder::expandCel(byte* target, const byte* source, const int16 celWidth, const int16 celHeight) const {
+void RobotDecoder::expandCel(byte* target, const byte* source, const int16 celWidth, const int16 celHeight, const uint8 verticalScaleFactor) const {
 	assert(source != nullptr && target != nullptr);
 
-	const int sourceHeight = (celHeight * _verticalScaleFactor) / 100;
+	const int sourceHeight = (celHeight * verticalScaleFactor) / 100;
 	assert(sourceHeight > 0);
 
 	const int16 numerator = celHeight;
@@ -1363,14 +1531,35 @@ void RobotDecoder::setPriority(const int16 newPriority) {
 }
 
 void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
+	const uint64 startTime = g_system->getMicros();
 	const RobotScreenItemList::size_type oldScreenItemCount = _screenItemList.size();
 	const int videoSize = _videoSizes[_currentFrameNo];
-	_doVersion5Scratch.resize(videoSize);
 
-	byte *videoFrameData = _doVersion5Scratch.begin();
+	const byte *videoFrameData = nullptr;
+	const byte *decompressedPixels = nullptr;
+	for (int i = 0; i < kReadAheadFrameCount; ++i) {
+		const ReadAheadFrame &frame = _readAheadFrames[i];
+		if (frame.frameNo == _currentFrameNo) {
+			videoFrameData = frame.data.begin();
+			if (frame.isDecompressed && !frame.pixels.empty()) {
+				decompressedPixels = frame.pixels.begin();
+			}
+			break;
+		}
+	}
 
-	if (!_stream->read(videoFrameData, videoSize)) {
-		error("RobotDecoder::doVersion5: Read error");
+	if (videoFrameData) {
+		++_decoderStats.readAheadHits;
+		if (decompressedPixels) {
+			++_decoderStats.decompressedAheadHits;
+		}
+	} else {
+		++_decoderStats.readAheadMisses;
+		_doVersion5Scratch.resize(videoSize);
+		if (!_stream->read(_doVersion5Scratch.begin(), videoSize)) {
+			error("RobotDecoder::doVersion5: Read error");
+		}
+		videoFrameData = _doVersion5Scratch.begin();
 	}
 
 	const RobotScreenItemList::size_type screenItemCount = READ_SCI11ENDIAN_UINT16(videoFrameData);
@@ -1395,7 +1584,7 @@ void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 		_originalScreenItemY.resize(screenItemCount);
 	}
 
-	createCels5(videoFrameData + 2, screenItemCount, true);
+	createCels5(videoFrameData + 2, screenItemCount, true, decompressedPixels);
 	for (RobotScreenItemList::size_type i = 0; i < screenItemCount; ++i) {
 		Common::Point position(_screenItemX[i], _screenItemY[i]);
 
@@ -1446,16 +1635,27 @@ void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 		_originalScreenItemX.resize(screenItemCount);
 		_originalScreenItemY.resize(screenItemCount);
 	}
+
+	const uint32 decodeTime = (uint32)(g_system->getMicros() - startTime);
+	++_decoderStats.framesDecoded;
+	_decoderStats.lastDecodeTime = decodeTime;
+	_decoderStats.totalDecodeTime += decodeTime;
+	_decoderStats.maxDecodeTime = MAX(_decoderStats.maxDecodeTime, decodeTime);
 }
 
-void RobotDecoder::createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette) {
+void RobotDecoder::createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette, const byte *decompressedPixels) {
 	preallocateCelMemory(rawVideoData, numCels);
 	for (int16 i = 0; i < numCels; ++i) {
-		rawVideoData += createCel5(rawVideoData, i, usePalette);
+		const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 2);
+		const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 4);
+		rawVideoData += createCel5(rawVideoData, i, usePalette, decompressedPixels);
+		if (decompressedPixels) {
+			decompressedPixels += celWidth * celHeight;
+		}
 	}
 }
 
-uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette) {
+uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette, const byte *decompressedPixels) {
 	_verticalScaleFactor = rawVideoData[1];
 	const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 2);
 	const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 4);
@@ -1514,16 +1714,35 @@ uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItem
 	assert(bitmap.getHunkPaletteOffset() == (uint32)bitmap.getWidth() * bitmap.getHeight() + SciBitmap::getBitmapHeaderSize());
 	bitmap.setOrigin(origin);
 
-	byte *targetBuffer;
-	if (_verticalScaleFactor == 100) {
-		// direct copy to bitmap
-		targetBuffer = bitmap.getPixels();
+	if (decompressedPixels) {
+		Common::copy(decompressedPixels, decompressedPixels + celWidth * celHeight, bitmap.getPixels());
 	} else {
-		// go through squashed cel decompressor
-		_celDecompressionBuffer.resize(_celDecompressionArea >= celWidth * (celHeight * _verticalScaleFactor / 100));
-		targetBuffer = _celDecompressionBuffer.begin();
+		byte *targetBuffer;
+		if (_verticalScaleFactor == 100) {
+			// direct copy to bitmap
+			targetBuffer = bitmap.getPixels();
+		} else {
+			// go through squashed cel decompressor
+			_celDecompressionBuffer.resize(_celDecompressionArea >= celWidth * (celHeight * _verticalScaleFactor / 100));
+			targetBuffer = _celDecompressionBuffer.begin();
+		}
+
+		decompressCelChunks(targetBuffer, rawVideoData, numDataChunks);
+
+		if (_verticalScaleFactor != 100) {
+			expandCel(bitmap.getPixels(), _celDecompressionBuffer.begin(), celWidth, celHeight, _verticalScaleFactor);
+		}
+	}
+
+	if (usePalette) {
+		Common::copy(_rawPalette, _rawPalette + kRawPaletteSize, bitmap.getHunkPalette());
 	}
 
+	return kCelHeaderSize + dataSize;
+}
+
+uint32 RobotDecoder::decompressCelChunks(byte *target, const byte *rawVideoData, const int16 numDataChunks) {
+	uint32 totalSize = 0;
 	for (int i = 0; i < numDataChunks; ++i) {
 		uint compressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData);
 		uint decompressedSize = READ_SCI11ENDIAN_UINT32(rawVideoData + 4);
@@ -1533,29 +1752,22 @@ uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItem
 		switch (compressionType) {
 		case kCompressionLZS: {
 			Common::MemoryReadStream videoDataStream(rawVideoData, compressedSize, DisposeAfterUse::NO);
-			_decompressor.unpack(&videoDataStream, targetBuffer, compressedSize, decompressedSize);
+			_decompressor.unpack(&videoDataStream, target, compressedSize, decompressedSize);
 			break;
 		}
 		case kCompressionNone:
-			Common::copy(rawVideoData, rawVideoData + decompressedSize, targetBuffer);
+			Common::copy(rawVideoData, rawVideoData + decompressedSize, target);
 			break;
 		default:
 			error("Unknown compression type %d!", compressionType);
 		}
 
 		rawVideoData += compressedSize;
-		targetBuffer += decompressedSize;
-	}
-
-	if (_verticalScaleFactor != 100) {
-		expandCel(bitmap.getPixels(), _celDecompressionBuffer.begin(), celWidth, celHeight);
+		target += decompressedSize;
+		totalSize += decompressedSize;
 	}
 
-	if (usePalette) {
-		Common::copy(_rawPalette, _rawPalette + kRawPaletteSize, bitmap.getHunkPalette());
-	}
-
-	return kCelHeaderSize + dataSize;
+	return totalSize;
 }
 
 void RobotDecoder::preallocateCelMemory(const byte *rawVideoData, const int16 numCels) {
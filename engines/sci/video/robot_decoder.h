@@ -35,6 +35,7 @@
 
 namespace Common { class SeekableSubReadStreamEndian; }
 namespace Sci {
+class Console;
 class Plane;
 class SegManager;
 
@@ -340,6 +341,11 @@ public:
 	 */
 	StreamState getStatus() const;
 
+	/**
+	 * Returns the number of decompressed samples ready to be played.
+	 */
+	int getNumBufferedSamples() const;
+
 private:
 	Common::Mutex _mutex;
 
@@ -641,6 +647,27 @@ public:
 	 */
 	RobotStatus getStatus() const;
 
+	/**
+	 * Performs one step of preparing the upcoming frames ahead of time:
+	 * either reads the raw video record of the next frame that has not been
+	 * read yet, or decompresses the cels of the next frame that has been read
+	 * but not decompressed. This moves disc access and decompression out of
+	 * doRobot into the time the engine would otherwise spend idle.
+	 *
+	 * @returns true if a step was performed, false if there was nothing to do.
+	 */
+	bool readAhead();
+
+	/**
+	 * Prints frame decoding statistics to the debugger console.
+	 */
+	void printDecoderStats(Console *con) const;
+
+	/**
+	 * Resets the frame decoding statistics.
+	 */
+	void resetDecoderStats();
+
 private:
 	/**
 	 * The read stream containing raw robot data.
@@ -1154,7 +1181,7 @@ public:
 	 * Scales a vertically compressed cel to its original uncompressed
 	 * dimensions.
 	 */
-	void expandCel(byte *target, const byte* source, const int16 celWidth, const int16 celHeight) const;
+	void expandCel(byte *target, const byte* source, const int16 celWidth, const int16 celHeight, const uint8 verticalScaleFactor) const;
 
 	int16 getPriority() const;
 
@@ -1216,16 +1243,25 @@ private:
 	void doVersion5(const bool shouldSubmitAudio = true);
 
 	/**
-	 * Creates screen items for a version 5/6 robot.
+	 * Creates screen items for a version 5/6 robot. If `decompressedPixels`
+	 * is given, it contains the already decompressed pixels of all cels of
+	 * the frame, one after the other.
 	 */
-	void createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette);
+	void createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette, const byte *decompressedPixels = nullptr);
 
 	/**
 	 * Creates a single screen item for a cel in a version 5/6 robot.
 	 *
 	 * Returns the size, in bytes, of the raw cel data.
 	 */
-	uint32 createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette);
+	uint32 createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette, const byte *decompressedPixels);
+
+	/**
+	 * Decompresses the `numDataChunks` data chunks of a cel which follow
+	 * the cel header in `rawVideoData` into `target`, and returns the total
+	 * decompressed size.
+	 */
+	uint32 decompressCelChunks(byte *target, const byte *rawVideoData, const int16 numDataChunks);
 
 	/**
 	 * Preallocates memory for the next `numCels` cels in the robot data stream.
@@ -1320,6 +1356,78 @@ private:
 	 */
 	ScratchMemory _doVersion5Scratch;
 
+	enum {
+		/**
+		 * The number of upcoming frames whose video records are read ahead
+		 * of time.
+		 */
+		kReadAheadFrameCount = 4
+	};
+
+	/**
+	 * A frame which has been read, and possibly decompressed, ahead of time.
+	 */
+	struct ReadAheadFrame {
+		/**
+		 * The frame number of the record, or -1 if the slot is unused.
+		 */
+		int frameNo;
+
+		/**
+		 * The compressed video data of the frame.
+		 */
+		ScratchMemory data;
+
+		/**
+		 * The decompressed, vertically expanded pixels of all cels of the
+		 * frame, one after the other.
+		 */
+		ScratchMemory pixels;
+
+		/**
+		 * If true, `pixels` holds the cels of the frame.
+		 */
+		bool isDecompressed;
+
+		ReadAheadFrame() : frameNo(-1), isDecompressed(false) {}
+	};
+
+	/**
+	 * Frames following the current frame.
+	 */
+	ReadAheadFrame _readAheadFrames[kReadAheadFrameCount];
+
+	/**
+	 * Scratch memory used to decompress vertically squashed cels of frames
+	 * which are read ahead.
+	 */
+	ScratchMemory _readAheadSquashedCel;
+
+	/**
+	 * Decompresses all cels of a frame which has been read ahead into its
+	 * `pixels` buffer.
+	 */
+	void decompressReadAheadFrame(ReadAheadFrame &frame);
+
+	/**
+	 * Discards all frames which have been read ahead.
+	 */
+	void clearReadAhead();
+
+	struct DecoderStats {
+		uint32 framesDecoded;
+		uint32 framesSkipped;
+		uint32 lateFrames;
+		uint32 readAheadHits;
+		uint32 readAheadMisses;
+		uint32 decompressedAheadHits;
+		uint32 lastDecodeTime; ///< us
+		uint32 maxDecodeTime; ///< us
+		uint64 totalDecodeTime; ///< us
+	};
+
+	DecoderStats _decoderStats;
+
 	/**
 	 * When set to a non-negative value, forces the next call to doRobot to
 	 * render the given frame number instead of whatever frame would have
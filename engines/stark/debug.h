@@ -29,7 +29,8 @@ enum {
 	kDebugXRC       = 1 << 2,
 	kDebugModding   = 1 << 3,
 	kDebugAnimation = 1 << 4,
-	kDebugUnknown   = 1 << 5
+	kDebugUnknown   = 1 << 5,
+	kDebugRender    = 1 << 6
 };
 
 #endif // STARK_DEBUG_H
@@ -97,12 +97,11 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 	setBonePositionArrayUniform(_shader, "bonePosition");
 	setLightArrayUniform(lights);
 
-	Common::Array<Face *> faces = _model->getFaces();
-	Common::Array<Material *> mats = _model->getMaterials();
+	const Common::Array<Material *> &mats = _model->getMaterials();
 
-	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		// For each face draw its vertices from the VBO, indexed by the EBO
-		const Material *material = mats[(*face)->materialId];
+	for (FaceBatchArray::const_iterator batch = _faceBatches.begin(); batch != _faceBatches.end(); ++batch) {
+		// For each material draw the vertices of its faces from the VBO, indexed by the EBO
+		const Material *material = mats[batch->materialId];
 		const Gfx::Texture *tex = resolveTexture(material);
 		if (tex) {
 			tex->bind();
@@ -113,9 +112,8 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		_shader->setUniform("textured", tex != nullptr);
 		_shader->setUniform("color", Math::Vector3d(material->r, material->g, material->b));
 
-		GLuint ebo = _faceEBO[*face];
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->ebo);
+		glDrawElements(GL_TRIANGLES, batch->indexCount, GL_UNSIGNED_INT, 0);
 	}
 
 	_shader->unbind();
@@ -144,10 +142,9 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		modelInverse.inverse();
 		setShadowUniform(lights, position, modelInverse.getRotation());
 
-		for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-			GLuint ebo = _faceEBO[*face];
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-			glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		for (FaceBatchArray::const_iterator batch = _faceBatches.begin(); batch != _faceBatches.end(); ++batch) {
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->ebo);
+			glDrawElements(GL_TRIANGLES, batch->indexCount, GL_UNSIGNED_INT, 0);
 		}
 
 		glDisable(GL_BLEND);
@@ -161,19 +158,26 @@ void OpenGLSActorRenderer::clearVertices() {
 	OpenGL::ShaderGL::freeBuffer(_faceVBO); // Zero names are silently ignored
 	_faceVBO = 0;
 
-	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
-		OpenGL::ShaderGL::freeBuffer(it->_value);
+	for (FaceBatchArray::iterator it = _faceBatches.begin(); it != _faceBatches.end(); ++it) {
+		OpenGL::ShaderGL::freeBuffer(it->ebo);
 	}
 
-	_faceEBO.clear();
+	_faceBatches.clear();
 }
 
 void OpenGLSActorRenderer::uploadVertices() {
 	_faceVBO = createModelVBO(_model);
 
-	Common::Array<Face *> faces = _model->getFaces();
-	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		_faceEBO[*face] = createFaceEBO(*face);
+	// Group the faces by material so that the render state only changes once per material
+	const Common::Array<Material *> &materials = _model->getMaterials();
+	for (uint32 materialId = 0; materialId < materials.size(); materialId++) {
+		FaceBatch batch;
+		batch.materialId = materialId;
+		batch.ebo = createBatchEBO(materialId, batch.indexCount);
+
+		if (batch.ebo) {
+			_faceBatches.push_back(batch);
+		}
 	}
 }
 
@@ -212,8 +216,22 @@ GLuint OpenGLSActorRenderer::createModelVBO(const Model *model) {
 	return vbo;
 }
 
-GLuint OpenGLSActorRenderer::createFaceEBO(const Face *face) {
-	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices[0]);
+GLuint OpenGLSActorRenderer::createBatchEBO(uint32 materialId, uint32 &indexCount) {
+	const Common::Array<Face *> &faces = _model->getFaces();
+
+	Common::Array<uint32> indices;
+	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
+		if ((*face)->materialId == materialId) {
+			indices.push_back((*face)->vertexIndices);
+		}
+	}
+
+	indexCount = indices.size();
+	if (indices.empty()) {
+		return 0;
+	}
+
+	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * indices.size(), &indices[0]);
 }
 
 void OpenGLSActorRenderer::setBonePositionArrayUniform(OpenGL::ShaderGL *shader, const char *uniform) {
@@ -26,8 +26,7 @@
 #include "engines/stark/gfx/renderentry.h"
 #include "engines/stark/visual/actor.h"
 
-#include "common/hashmap.h"
-#include "common/hash-ptr.h"
+#include "common/array.h"
 
 #include "graphics/opengl/system_headers.h"
 
@@ -50,18 +49,25 @@ public:
 	void render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) override;
 
 protected:
-	typedef Common::HashMap<Face *, GLuint> FaceBufferMap;
+	/** The faces of the model using the same material, drawn with a single call */
+	struct FaceBatch {
+		uint32 materialId;
+		uint32 indexCount;
+		GLuint ebo;
+	};
+
+	typedef Common::Array<FaceBatch> FaceBatchArray;
 
 	OpenGLSDriver *_gfx;
 	OpenGL::ShaderGL *_shader, *_shadowShader;
 
 	GLuint _faceVBO;
-	FaceBufferMap _faceEBO;
+	FaceBatchArray _faceBatches;
 
 	void clearVertices();
 	void uploadVertices();
 	GLuint createModelVBO(const Model *model);
-	GLuint createFaceEBO(const Face *face);
+	GLuint createBatchEBO(uint32 materialId, uint32 &indexCount);
 	void setBonePositionArrayUniform(OpenGL::ShaderGL *shader, const char *uniform);
 	void setBoneRotationArrayUniform(OpenGL::ShaderGL *shader, const char *uniform);
 	void setLightArrayUniform(const LightEntryArray &lights);
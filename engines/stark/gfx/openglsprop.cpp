@@ -85,13 +85,12 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 	_shader->setUniform("normalMatrix", normalMatrix.getRotation());
 	setLightArrayUniform(lights);
 
-	const Common::Array<Face> &faces = _model->getFaces();
 	const Common::Array<Material> &materials = _model->getMaterials();
 
-	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		const Material &material = materials[face->materialId];
+	for (FaceBatchArray::const_iterator batch = _faceBatches.begin(); batch != _faceBatches.end(); ++batch) {
+		const Material &material = materials[batch->materialId];
 
-		// For each face draw its vertices from the VBO, indexed by the EBO
+		// For each material draw the vertices of its faces from the VBO, indexed by the EBO
 		const Gfx::Texture *tex = _texture->getTexture(material.texture);
 		if (tex) {
 			tex->bind();
@@ -103,9 +102,8 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 		_shader->setUniform("color", Math::Vector3d(material.r, material.g, material.b));
 		_shader->setUniform("doubleSided", material.doubleSided ? 1 : 0);
 
-		GLuint ebo = _faceEBO[face];
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glDrawElements(GL_TRIANGLES, face->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->ebo);
+		glDrawElements(GL_TRIANGLES, batch->indexCount, GL_UNSIGNED_INT, 0);
 	}
 
 	_shader->unbind();
@@ -113,20 +111,28 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 
 void OpenGLSPropRenderer::clearVertices() {
 	OpenGL::ShaderGL::freeBuffer(_faceVBO);
+	_faceVBO = 0;
 
-	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
-		OpenGL::ShaderGL::freeBuffer(it->_value);
+	for (FaceBatchArray::iterator it = _faceBatches.begin(); it != _faceBatches.end(); ++it) {
+		OpenGL::ShaderGL::freeBuffer(it->ebo);
 	}
 
-	_faceEBO.clear();
+	_faceBatches.clear();
 }
 
 void OpenGLSPropRenderer::uploadVertices() {
 	_faceVBO = createFaceVBO();
 
-	const Common::Array<Face> &faces = _model->getFaces();
-	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		_faceEBO[face] = createFaceEBO(face);
+	// Group the faces by material so that the render state only changes once per material
+	const Common::Array<Material> &materials = _model->getMaterials();
+	for (uint32 materialId = 0; materialId < materials.size(); materialId++) {
+		FaceBatch batch;
+		batch.materialId = materialId;
+		batch.ebo = createBatchEBO(materialId, batch.indexCount);
+
+		if (batch.ebo) {
+			_faceBatches.push_back(batch);
+		}
 	}
 }
 
@@ -136,8 +142,22 @@ GLuint OpenGLSPropRenderer::createFaceVBO() {
 	return OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, sizeof(float) * 9 * vertices.size(), &vertices.front());
 }
 
-GLuint OpenGLSPropRenderer::createFaceEBO(const Face *face) {
-	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices.front());
+GLuint OpenGLSPropRenderer::createBatchEBO(uint32 materialId, uint32 &indexCount) {
+	const Common::Array<Face> &faces = _model->getFaces();
+
+	Common::Array<uint32> indices;
+	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
+		if (face->materialId == materialId) {
+			indices.push_back(face->vertexIndices);
+		}
+	}
+
+	indexCount = indices.size();
+	if (indices.empty()) {
+		return 0;
+	}
+
+	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * indices.size(), &indices.front());
 }
 
 void OpenGLSPropRenderer::setLightArrayUniform(const LightEntryArray &lights) {
@@ -26,8 +26,7 @@
 #include "engines/stark/model/model.h"
 #include "engines/stark/visual/prop.h"
 
-#include "common/hashmap.h"
-#include "common/hash-ptr.h"
+#include "common/array.h"
 
 #include "graphics/opengl/system_headers.h"
 
@@ -51,19 +50,26 @@ public:
 	void render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) override;
 
 protected:
-	typedef Common::HashMap<const Face *, GLuint> FaceBufferMap;
+	/** The faces of the model using the same material, drawn with a single call */
+	struct FaceBatch {
+		uint32 materialId;
+		uint32 indexCount;
+		GLuint ebo;
+	};
+
+	typedef Common::Array<FaceBatch> FaceBatchArray;
 
 	Driver *_gfx;
 	OpenGL::ShaderGL *_shader;
 
 	bool _modelIsDirty;
 	GLuint _faceVBO;
-	FaceBufferMap _faceEBO;
+	FaceBatchArray _faceBatches;
 
 	void clearVertices();
 	void uploadVertices();
 	GLuint createFaceVBO();
-	GLuint createFaceEBO(const Face *face);
+	GLuint createBatchEBO(uint32 materialId, uint32 &indexCount);
 
 	void setLightArrayUniform(const LightEntryArray &lights);
 
@@ -70,6 +70,7 @@ StarkEngine::StarkEngine(OSystem *syst, const ADGameDescription *gameDesc) :
 	DebugMan.addDebugChannel(kDebugModding, "Modding", "Debug the loading of modded assets");
 	DebugMan.addDebugChannel(kDebugAnimation, "Animation", "Debug the animation changes");
 	DebugMan.addDebugChannel(kDebugUnknown, "Unknown", "Debug unknown values on the data");
+	DebugMan.addDebugChannel(kDebugRender, "Render", "Debug the time spent rendering the scene");
 
 	addModsToSearchPath();
 }
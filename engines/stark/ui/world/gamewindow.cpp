@@ -22,6 +22,7 @@
 
 #include "engines/stark/ui/world/gamewindow.h"
 
+#include "engines/stark/debug.h"
 #include "engines/stark/scene.h"
 
 #include "engines/stark/gfx/driver.h"
@@ -46,6 +47,9 @@
 #include "engines/stark/visual/text.h"
 #include "engines/stark/visual/image.h"
 
+#include "common/debug.h"
+#include "common/system.h"
+
 namespace Stark {
 
 GameWindow::GameWindow(Gfx::Driver *gfx, Cursor *cursor, ActionMenu *actionMenu, InventoryWindow *inventory) :
@@ -53,7 +57,10 @@ GameWindow::GameWindow(Gfx::Driver *gfx, Cursor *cursor, ActionMenu *actionMenu,
 	_actionMenu(actionMenu),
 	_inventory(inventory),
 	_objectUnderCursor(nullptr),
-	_displayExit(false) {
+	_displayExit(false),
+	_renderTimeTotal(0),
+	_renderTimeFrames(0),
+	_renderTimeReportStart(0) {
 	_position = Common::Rect(Gfx::Driver::kGameViewportWidth, Gfx::Driver::kGameViewportHeight);
 	_position.translate(0, Gfx::Driver::kTopBorderHeight);
 	_visible = true;
@@ -78,6 +85,8 @@ void GameWindow::onRender() {
 	_renderEntries = location->listRenderEntries();
 	Gfx::LightEntryArray lightEntries = location->listLightEntries();
 
+	uint32 renderStart = g_system->getMillis();
+
 	// Render all the scene items
 	Gfx::RenderEntryArray::iterator element = _renderEntries.begin();
 	while (element != _renderEntries.end()) {
@@ -88,6 +97,19 @@ void GameWindow::onRender() {
 		element++;
 	}
 
+	uint32 renderEnd = g_system->getMillis();
+	_renderTimeTotal += renderEnd - renderStart;
+	_renderTimeFrames++;
+
+	if (renderEnd - _renderTimeReportStart >= 1000) {
+		debugC(kDebugRender, "Rendered %d scene entries, %.2f ms per frame on average over %d frames",
+		       _renderEntries.size(), _renderTimeTotal / (float)_renderTimeFrames, _renderTimeFrames);
+
+		_renderTimeTotal = 0;
+		_renderTimeFrames = 0;
+		_renderTimeReportStart = renderEnd;
+	}
+
 	if (_displayExit) {
 		Common::Array<Common::Point> exitPositions = StarkGameInterface->listExitPositions();
 
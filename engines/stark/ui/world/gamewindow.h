@@ -73,6 +73,11 @@ protected:
 	int _exitLeftBoundary, _exitRightBoundary;
 
 	bool _displayExit;
+
+	// Time spent submitting the scene render entries, reported on the Render debug channel
+	uint32 _renderTimeTotal;
+	uint32 _renderTimeFrames;
+	uint32 _renderTimeReportStart;
 };
 
 } // End of namespace Stark
@@ -35,6 +35,10 @@
 #include "graphics/surface.h"
 #include "graphics/VectorRendererSpec.h"
 
+#ifdef USE_TINYGL
+#include "graphics/tinygl/zgl.h"
+#endif
+
 namespace Testbed {
 
 byte GFXTestSuite::_palette[256 * 3] = {0, 0, 0, 255, 255, 255, 255, 255, 255};
@@ -68,6 +72,10 @@ GFXTestSuite::GFXTestSuite() {
 	addTest("PaletteRotation", &GFXtests::paletteRotation);
 	addTest("cursorTrailsInGUI", &GFXtests::cursorTrails);
 	//addTest("Pixel Formats", &GFXtests::pixelFormats);
+
+#ifdef USE_TINYGL
+	addTest("TinyGLBenchmark", &GFXtests::tinyGLBenchmark, false);
+#endif
 }
 
 void GFXTestSuite::prepare() {
@@ -1316,4 +1324,119 @@ TestExitStatus GFXtests::pixelFormats() {
 	return kTestPassed;
 }
 
+#ifdef USE_TINYGL
+
+namespace {
+
+enum TinyGLWorkload {
+	kTinyGLFlat,
+	kTinyGLSmooth,
+	kTinyGLTextured,
+	kTinyGLBlended,
+	kTinyGLHidden
+};
+
+/**
+ * Draw screen sized quads with the given workload and return the
+ * time taken to rasterize them, in milliseconds.
+ */
+uint32 renderTinyGLWorkload(TinyGLWorkload workload, int quadCount) {
+	tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+	tglEnable(TGL_DEPTH_TEST);
+	tglDepthFunc(TGL_LESS);
+	tglShadeModel(workload == kTinyGLFlat ? TGL_FLAT : TGL_SMOOTH);
+	if (workload == kTinyGLTextured || workload == kTinyGLBlended)
+		tglEnable(TGL_TEXTURE_2D);
+	else
+		tglDisable(TGL_TEXTURE_2D);
+	if (workload == kTinyGLBlended) {
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		tglDepthMask(TGL_FALSE);
+	} else {
+		tglDisable(TGL_BLEND);
+		tglDepthMask(TGL_TRUE);
+	}
+
+	for (int i = 0; i < quadCount; i++) {
+		// Hidden quads all have the same depth, so that every quad
+		// after the first one fails the depth test
+		float z = workload == kTinyGLHidden ? 0.0f : 0.9f - i * 1.8f / quadCount;
+
+		tglBegin(TGL_QUADS);
+		tglColor4f(1.0f, 0.0f, 0.0f, 0.5f);
+		tglTexCoord2f(0.0f, 0.0f);
+		tglVertex3f(-1.0f, -1.0f, z);
+		tglColor4f(0.0f, 1.0f, 0.0f, 0.5f);
+		tglTexCoord2f(4.0f, 0.0f);
+		tglVertex3f(1.0f, -1.0f, z);
+		tglColor4f(0.0f, 0.0f, 1.0f, 0.5f);
+		tglTexCoord2f(4.0f, 4.0f);
+		tglVertex3f(1.0f, 1.0f, z);
+		tglColor4f(1.0f, 1.0f, 1.0f, 0.5f);
+		tglTexCoord2f(0.0f, 4.0f);
+		tglVertex3f(-1.0f, 1.0f, z);
+		tglEnd();
+	}
+
+	// Draw calls are deferred, the rasterization happens here
+	uint32 startTime = g_system->getMillis();
+	TinyGL::tglPresentBuffer();
+	return g_system->getMillis() - startTime;
+}
+
+} // End of anonymous namespace
+
+TestExitStatus GFXtests::tinyGLBenchmark() {
+	const int width = 640, height = 480;
+	const int quadCount = 64;
+	const char *workloadNames[] = { "flat", "smooth", "textured", "blended", "hidden" };
+
+	TinyGL::FrameBuffer *fb = new TinyGL::FrameBuffer(width, height, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	TinyGL::glInit(fb, 256);
+	tglEnableDirtyRects(false);
+
+	tglViewport(0, 0, width, height);
+	tglMatrixMode(TGL_PROJECTION);
+	tglLoadIdentity();
+	tglMatrixMode(TGL_MODELVIEW);
+	tglLoadIdentity();
+
+	// A checkerboard texture
+	byte *texels = new byte[256 * 256 * 4];
+	for (int y = 0; y < 256; y++) {
+		for (int x = 0; x < 256; x++) {
+			byte value = ((x ^ y) & 0x10) ? 0xff : 0x40;
+			byte *texel = texels + (y * 256 + x) * 4;
+			texel[0] = value;
+			texel[1] = x;
+			texel[2] = y;
+			texel[3] = 0xc0;
+		}
+	}
+	TGLuint texture;
+	tglGenTextures(1, &texture);
+	tglBindTexture(TGL_TEXTURE_2D, texture);
+	tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_WRAP_S, TGL_REPEAT);
+	tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_WRAP_T, TGL_REPEAT);
+	tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, 256, 256, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, texels);
+	delete[] texels;
+
+	for (int i = 0; i < ARRAYSIZE(workloadNames); i++) {
+		uint32 time = MAX<uint32>(renderTinyGLWorkload((TinyGLWorkload)i, quadCount), 1);
+		uint32 pixels = width * height * quadCount;
+		Testsuite::logPrintf("Info! TinyGL %s quads: %u pixels in %u ms, %u.%02u Mpixels/s\n",
+			workloadNames[i], pixels, time, pixels / time / 1000, (pixels / time / 10) % 100);
+	}
+
+	tglDeleteTextures(1, &texture);
+	TinyGL::glClose();
+	delete fb;
+
+	return kTestPassed;
+}
+
+#endif
+
 } // End of namespace Testbed
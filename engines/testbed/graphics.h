@@ -53,6 +53,7 @@ TestExitStatus focusRectangle();
 TestExitStatus overlayGraphics();
 TestExitStatus paletteRotation();
 TestExitStatus pixelFormats();
+TestExitStatus tinyGLBenchmark();
 // add more here
 
 } // End of namespace GFXtests
@@ -20,6 +20,11 @@
  *
  */
 
+#include "audio/audiostream.h"
+#include "audio/decoders/flac.h"
+#include "audio/decoders/mp3.h"
+#include "audio/decoders/quicktime.h"
+#include "audio/decoders/vorbis.h"
 #include "audio/softsynth/pcspk.h"
 
 #include "backends/audiocd/audiocd.h"
@@ -261,6 +266,96 @@ TestExitStatus SoundSubsystem::sampleRates() {
 	return passed;
 }
 
+namespace {
+
+typedef Audio::SeekableAudioStream *(*CodecStreamFactory)(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+
+struct CodecBenchmarkFormat {
+	const char *name;
+	const char *extension;
+	CodecStreamFactory factory;
+};
+
+const CodecBenchmarkFormat codecBenchmarkFormats[] = {
+#ifdef USE_FLAC
+	{ "FLAC",         ".flac", Audio::makeFLACStream },
+#endif
+#ifdef USE_VORBIS
+	{ "Ogg Vorbis",   ".ogg",  Audio::makeVorbisStream },
+#endif
+#ifdef USE_MAD
+	{ "MPEG Layer 3", ".mp3",  Audio::makeMP3Stream },
+#endif
+	{ "MPEG-4 Audio", ".m4a",  Audio::makeQuickTimeStream }
+};
+
+} // End of anonymous namespace
+
+TestExitStatus SoundSubsystem::codecBenchmark() {
+	Testsuite::clearScreen();
+	Common::String info = "Audio codec benchmark.\n"
+	"Every supported file in game-dir/audiocodec-files is decoded as fast as possible,\n"
+	"without playing it, and the decoding speed is written to the log.";
+
+	if (Testsuite::handleInteractiveInput(info, "OK", "Skip", kOptionRight)) {
+		Testsuite::logPrintf("Info! Skipping test : Audio codec benchmark\n");
+		return kTestSkipped;
+	}
+
+	Common::FSNode dir = Common::FSNode(ConfMan.get("path")).getChild("audiocodec-files");
+	Common::FSList files;
+	if (!dir.isDirectory() || !dir.getChildren(files, Common::FSNode::kListFilesOnly)) {
+		Testsuite::logDetailedPrintf("Error! Unable to list game-dir/audiocodec-files\n");
+		return kTestFailed;
+	}
+
+	// Decode into a fixed buffer, like the mixer does, and throw the data away
+	int16 buffer[4096];
+	TestExitStatus passed = kTestPassed;
+
+	for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
+		const Common::String name = file->getName();
+
+		const CodecBenchmarkFormat *format = nullptr;
+		for (int i = 0; i < ARRAYSIZE(codecBenchmarkFormats); i++) {
+			if (name.hasSuffixIgnoreCase(codecBenchmarkFormats[i].extension))
+				format = &codecBenchmarkFormats[i];
+		}
+		if (!format)
+			continue;
+
+		Common::SeekableReadStream *fileStream = file->createReadStream();
+		Audio::SeekableAudioStream *stream = fileStream ? format->factory(fileStream, DisposeAfterUse::YES) : nullptr;
+		if (!stream) {
+			Testsuite::logDetailedPrintf("Error! Unable to open %s as %s\n", name.c_str(), format->name);
+			passed = kTestFailed;
+			continue;
+		}
+
+		uint32 samples = 0;
+		uint32 calls = 0;
+		const uint32 startTime = g_system->getMillis();
+
+		while (!stream->endOfData()) {
+			const int read = stream->readBuffer(buffer, ARRAYSIZE(buffer));
+			calls++;
+			if (read <= 0)
+				break;
+			samples += read;
+		}
+
+		const uint32 decodeTime = MAX<uint32>(g_system->getMillis() - startTime, 1);
+		const uint32 frames = samples / (stream->isStereo() ? 2 : 1);
+		Testsuite::logPrintf("Info! %s (%s): %u samples in %u readBuffer calls, %u ms, %u samples/s, %ux realtime\n",
+			name.c_str(), format->name, samples, calls, decodeTime,
+			(uint32)((uint64)samples * 1000 / decodeTime), (uint32)((uint64)frames * 1000 / decodeTime / stream->getRate()));
+
+		delete stream;
+	}
+
+	return passed;
+}
+
 SoundSubsystemTestSuite::SoundSubsystemTestSuite() {
 	addTest("SimpleBeeps", &SoundSubsystem::playBeeps, true);
 	addTest("MixSounds", &SoundSubsystem::mixSounds, true);
@@ -276,6 +371,9 @@ SoundSubsystemTestSuite::SoundSubsystemTestSuite() {
 		}
 	}
 	addTest("SampleRates", &SoundSubsystem::sampleRates, true);
+
+	if (Common::FSNode(ConfMan.get("path")).getChild("audiocodec-files").isDirectory())
+		addTest("CodecBenchmark", &SoundSubsystem::codecBenchmark, false);
 }
 
 } // End of namespace Testbed
@@ -546,6 +546,15 @@ void tglTexImage2D(int target, int level, int components, int width, int height,
 	TinyGL::gl_add_op(p);
 }
 
+void tglGenerateMipmap(int target) {
+	TinyGL::GLParam p[2];
+
+	p[0].op = TinyGL::OP_GenerateMipmap;
+	p[1].i = target;
+
+	TinyGL::gl_add_op(p);
+}
+
 void tglBindTexture(int target, int texture) {
 	TinyGL::GLParam p[3];
 
@@ -690,3 +699,11 @@ void tglEnableDirtyRects(bool enable) {
 	TinyGL::GLContext *c = TinyGL::gl_get_context();
 	c->_enableDirtyRectangles = enable;
 }
+
+void tglGetDirtyRectStats(int *redrawnPixels, int *totalPixels, int *reusedDrawCalls, int *totalDrawCalls) {
+	TinyGL::GLContext *c = TinyGL::gl_get_context();
+	*redrawnPixels = c->_redrawnPixels;
+	*totalPixels = c->_totalPixels;
+	*reusedDrawCalls = c->_reusedDrawCalls;
+	*totalDrawCalls = c->_totalDrawCalls;
+}
@@ -77,18 +77,111 @@ void glopArrayElement(GLContext *c, GLParam *param) {
 	}
 }
 
-void glopDrawArrays(GLContext *c, GLParam *p) {
-	GLParam array_element[2];
+// Fill the vertex array for a whole batch of elements at once, then transform
+// it in a single pass. This gives the same result as calling glopArrayElement()
+// for each element, but without going through glopColor()/glopVertex() per vertex.
+template<typename IndexType>
+static void gl_draw_elements(GLContext *c, int mode, int first, int count, const IndexType *indices) {
 	GLParam begin[2];
-	begin[1].i = p[1].i;
+	begin[1].i = mode;
 	glopBegin(c, begin);
-	for (int i=0; i < p[3].i; i++) {
-		array_element[1].i = p[2].i + i;
+
+	int states = c->client_states;
+	if (c->lighting_enabled || !(states & VERTEX_ARRAY)) {
+		// lighting needs the current normal of each vertex, just go the slow way
+		GLParam array_element[2];
+		for (int i = 0; i < count; i++) {
+			array_element[1].i = indices ? indices[i] : first + i;
+			glopArrayElement(c, array_element);
+		}
+		glopEnd(c, NULL);
+		return;
+	}
+
+	gl_reserve_vertices(c, count);
+
+	int idx = 0;
+	for (int n = 0; n < count; n++) {
+		GLVertex *v = &c->vertex[n];
+		int i;
+		idx = indices ? indices[n] : first + n;
+
+		if (states & COLOR_ARRAY) {
+			int size = c->color_array_size;
+			i = idx * (size + c->color_array_stride);
+			v->color.X = c->color_array[i];
+			v->color.Y = c->color_array[i + 1];
+			v->color.Z = c->color_array[i + 2];
+			v->color.W = size > 3 ? c->color_array[i + 3] : 1.0f;
+		} else {
+			v->color = c->current_color;
+		}
+
+		if (c->texture_2d_enabled) {
+			if (states & TEXCOORD_ARRAY) {
+				int size = c->texcoord_array_size;
+				i = idx * (size + c->texcoord_array_stride);
+				v->tex_coord.X = c->texcoord_array[i];
+				v->tex_coord.Y = c->texcoord_array[i + 1];
+				v->tex_coord.Z = size > 2 ? c->texcoord_array[i + 2] : 0.0f;
+				v->tex_coord.W = size > 3 ? c->texcoord_array[i + 3] : 1.0f;
+			} else {
+				v->tex_coord = c->current_tex_coord;
+			}
+			if (c->apply_texture_matrix) {
+				Vector4 tex_coord = v->tex_coord;
+				c->matrix_stack_ptr[2]->transform(tex_coord, v->tex_coord);
+			}
+		}
+
+		int size = c->vertex_array_size;
+		i = idx * (size + c->vertex_array_stride);
+		v->coord.X = c->vertex_array[i];
+		v->coord.Y = c->vertex_array[i + 1];
+		v->coord.Z = size > 2 ? c->vertex_array[i + 2] : 0.0f;
+		v->coord.W = size > 3 ? c->vertex_array[i + 3] : 1.0f;
+
+		v->edge_flag = c->current_edge_flag;
+	}
+
+	gl_vertex_transform_batch(c, c->vertex, count);
+
+	c->vertex_n = count;
+	c->vertex_cnt = count;
+
+	// leave the current state as the last element would have
+	if (count > 0) {
+		GLParam array_element[2];
+		array_element[1].i = idx;
+		c->client_states = states & ~VERTEX_ARRAY;
 		glopArrayElement(c, array_element);
+		c->client_states = states;
 	}
+
 	glopEnd(c, NULL);
 }
 
+void glopDrawArrays(GLContext *c, GLParam *p) {
+	gl_draw_elements<int>(c, p[1].i, p[2].i, p[3].i, NULL);
+}
+
+void glopDrawElements(GLContext *c, GLParam *p) {
+	switch (p[3].i) {
+	case TGL_UNSIGNED_BYTE:
+		gl_draw_elements(c, p[1].i, 0, p[2].i, (const byte *)p[4].p);
+		break;
+	case TGL_UNSIGNED_SHORT:
+		gl_draw_elements(c, p[1].i, 0, p[2].i, (const uint16 *)p[4].p);
+		break;
+	case TGL_UNSIGNED_INT:
+		gl_draw_elements(c, p[1].i, 0, p[2].i, (const uint32 *)p[4].p);
+		break;
+	default:
+		assert(0);
+		break;
+	}
+}
+
 void glopEnableClientState(GLContext *c, GLParam *p) {
 	c->client_states |= p[1].i;
 }
@@ -138,6 +231,16 @@ void tglDrawArrays(TGLenum mode, TGLint first, TGLsizei count) {
 	gl_add_op(p);
 }
 
+void tglDrawElements(TGLenum mode, TGLsizei count, TGLenum type, const TGLvoid *indices) {
+	TinyGL::GLParam p[5];
+	p[0].op = TinyGL::OP_DrawElements;
+	p[1].i = mode;
+	p[2].i = count;
+	p[3].i = type;
+	p[4].p = const_cast<void *>(indices);
+	gl_add_op(p);
+}
+
 void tglEnableClientState(TGLenum array) {
 	TinyGL::GLParam p[2];
 	p[0].op = TinyGL::OP_EnableClientState;
@@ -801,10 +801,16 @@ void tglLoadName(unsigned int name);
 // textures
 void tglGenTextures(int n, unsigned int *textures);
 void tglDeleteTextures(int n, const unsigned int *textures);
+// Mipmaps are not generated past the budget, in bytes, 0 for no limit
+void tglSetTextureMemoryBudget(unsigned int budget);
+void tglGetTextureMemoryStats(unsigned int *memoryUsed, unsigned int *mipmapMemoryUsed);
 void tglBindTexture(int target, int texture);
 void tglTexImage2D(int target, int level, int components,
 				   int width, int height, int border,
 				   int format, int type, void *pixels);
+// Rebuilds the levels of the bound texture from its base level, like uploading
+// it again with a mipmap minification filter does
+void tglGenerateMipmap(int target);
 void tglTexEnvi(int target, int pname, int param);
 void tglTexParameteri(int target, int pname, int param);
 void tglPixelStorei(int pname, int param);
@@ -841,6 +847,7 @@ void tglEnableClientState(TGLenum array);
 void tglDisableClientState(TGLenum array);
 void tglArrayElement(TGLint i);
 void tglDrawArrays(TGLenum mode, TGLint first, TGLsizei count);
+void tglDrawElements(TGLenum mode, TGLsizei count, TGLenum type, const TGLvoid *indices);
 void tglVertexPointer(TGLint size, TGLenum type, TGLsizei stride, const TGLvoid *pointer);
 void tglColorPointer(TGLint size, TGLenum type, TGLsizei stride, const TGLvoid *pointer);
 void tglNormalPointer(TGLenum type, TGLsizei stride, const TGLvoid *pointer);
@@ -850,6 +857,8 @@ void tglTexCoordPointer(TGLint size, TGLenum type, TGLsizei stride, const TGLvoi
 void tglPolygonOffset(TGLfloat factor, TGLfloat units);
 
 void tglEnableDirtyRects(bool enable);
+// Number of pixels re-rasterized and draw calls skipped by the last tglPresentBuffer()
+void tglGetDirtyRectStats(int *redrawnPixels, int *totalPixels, int *reusedDrawCalls, int *totalDrawCalls);
 
 void tglDebug(int mode);
 
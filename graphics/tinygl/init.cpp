@@ -234,6 +234,8 @@ void glInit(void *zbuffer1, int textureSize) {
 	c->_drawCallAllocator[0].initialize(kDrawCallMemory);
 	c->_drawCallAllocator[1].initialize(kDrawCallMemory);
 	c->_enableDirtyRectangles = true;
+	c->_redrawnPixels = c->_totalPixels = 0;
+	c->_reusedDrawCalls = c->_totalDrawCalls = 0;
 
 	Graphics::Internal::tglBlitResetScissorRect();
 }
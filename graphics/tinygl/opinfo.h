@@ -67,6 +67,7 @@ ADD_OP(PopName, 0, "")
 ADD_OP(LoadName, 1, "%d")
 
 ADD_OP(TexImage2D, 9, "%d %d %d %d %d %d %d %d %d")
+ADD_OP(GenerateMipmap, 1, "%C")
 ADD_OP(BindTexture, 2, "%C %d")
 ADD_OP(TexEnv, 7, "%C %C %C %f %f %f %f")
 ADD_OP(TexParameter, 7, "%C %C %C %f %f %f %f")
@@ -92,6 +93,7 @@ ADD_OP(NextBuffer, 1, "%p")
 // opengl 1.1 arrays
 ADD_OP(ArrayElement, 1, "%d")
 ADD_OP(DrawArrays, 3, "%C %d %d")
+ADD_OP(DrawElements, 4, "%C %d %C %p")
 ADD_OP(EnableClientState, 1, "%C")
 ADD_OP(DisableClientState, 1, "%C")
 ADD_OP(VertexPointer, 4, "%d %C %d %p")
@@ -37,6 +37,8 @@ TexelBuffer::TexelBuffer(unsigned int width, unsigned int height, unsigned int t
 
 	_width = width;
 	_height = height;
+	_paddedWidth = (width + TEXEL_TILE_MASK) & ~TEXEL_TILE_MASK;
+	_paddedHeight = (height + TEXEL_TILE_MASK) & ~TEXEL_TILE_MASK;
 	_fracTextureUnit = textureSize << ZB_POINT_ST_FRAC_BITS;
 	_fracTextureMask = _fracTextureUnit - 1;
 	_widthRatio = (float) width / textureSize;
@@ -71,21 +73,31 @@ void TexelBuffer::getARGBAt(
 	x = wrap(wrap_s, s, _fracTextureUnit, _fracTextureMask) * _widthRatio;
 	y = wrap(wrap_t, t, _fracTextureUnit, _fracTextureMask) * _heightRatio;
 	getARGBAt(
-		(x >> ZB_POINT_ST_FRAC_BITS) + (y >> ZB_POINT_ST_FRAC_BITS) * _width,
+		tiledOffset(x >> ZB_POINT_ST_FRAC_BITS, y >> ZB_POINT_ST_FRAC_BITS),
 		x & ZB_POINT_ST_FRAC_MASK, y & ZB_POINT_ST_FRAC_MASK,
 		a, r, g, b
 	);
 }
 
-// Nearest: store texture in original size.
+// Nearest: store texture in original size, converted to ARGB once instead
+// of on every sample.
 NearestTexelBuffer::NearestTexelBuffer(const PixelBuffer &buf, unsigned int width, unsigned int height, unsigned int textureSize) : TexelBuffer(width, height, textureSize) {
-	unsigned int pixel_count = _width * _height;
-	_buf = PixelBuffer(buf.getFormat(), pixel_count, DisposeAfterUse::NO);
-	_buf.copyBuffer(0, pixel_count, buf);
+	_texels = new uint32[_paddedWidth * _paddedHeight]();
+	for (unsigned int y = 0; y < _height; y++) {
+		for (unsigned int x = 0; x < _width; x++) {
+			uint8 a, r, g, b;
+			buf.getARGBAt(y * _width + x, a, r, g, b);
+			_texels[tiledOffset(x, y)] = (a << 24) | (r << 16) | (g << 8) | b;
+		}
+	}
 }
 
 NearestTexelBuffer::~NearestTexelBuffer() {
-	_buf.free();
+	delete[] _texels;
+}
+
+unsigned int NearestTexelBuffer::getMemorySize() const {
+	return _paddedWidth * _paddedHeight * sizeof(uint32);
 }
 
 void NearestTexelBuffer::getARGBAt(
@@ -93,7 +105,11 @@ void NearestTexelBuffer::getARGBAt(
 	unsigned int, unsigned int,
 	uint8 &a, uint8 &r, uint8 &g, uint8 &b
 ) const {
-	_buf.getARGBAt(pixel, a, r, g, b);
+	uint32 texel = _texels[pixel];
+	a = texel >> 24;
+	r = texel >> 16;
+	g = texel >> 8;
+	b = texel;
 }
 
 // Bilinear: each texture coordinates corresponds to the 4 original image
@@ -115,12 +131,11 @@ void NearestTexelBuffer::getARGBAt(
 BilinearTexelBuffer::BilinearTexelBuffer(const PixelBuffer &buf, unsigned int width, unsigned int height, unsigned int textureSize) : TexelBuffer(width, height, textureSize) {
 	unsigned int pixel00_offset = 0, pixel11_offset, pixel01_offset, pixel10_offset;
 	uint8 *texel8;
-	uint32 *texel32;
 
-	texel32 = _texels = new uint32[_width * _height << PIXEL_PER_TEXEL_SHIFT];
+	_texels = new uint32[_paddedWidth * _paddedHeight << PIXEL_PER_TEXEL_SHIFT]();
 	for (unsigned int y = 0; y < _height; y++) {
 		for (unsigned int x = 0; x < _width; x++) {
-			texel8 = (uint8 *)texel32;
+			texel8 = (uint8 *)(_texels + (tiledOffset(x, y) << PIXEL_PER_TEXEL_SHIFT));
 			pixel11_offset = pixel00_offset + _width + 1;
 			buf.getARGBAt(
 				pixel00_offset,
@@ -160,7 +175,6 @@ BilinearTexelBuffer::BilinearTexelBuffer(const PixelBuffer &buf, unsigned int wi
 				*(texel8 + P11_OFFSET + G_OFFSET),
 				*(texel8 + P11_OFFSET + B_OFFSET)
 			);
-			texel32 += 1 << PIXEL_PER_TEXEL_SHIFT;
 			pixel00_offset++;
 		}
 	}
@@ -170,6 +184,10 @@ BilinearTexelBuffer::~BilinearTexelBuffer() {
 	delete[] _texels;
 }
 
+unsigned int BilinearTexelBuffer::getMemorySize() const {
+	return (_paddedWidth * _paddedHeight << PIXEL_PER_TEXEL_SHIFT) * sizeof(uint32);
+}
+
 static inline int interpolate(int v00, int v01, int v10, int xf, int yf) {
 	return v00 + (((v01 - v00) * xf + (v10 - v00) * yf) >> ZB_POINT_ST_FRAC_BITS);
 }
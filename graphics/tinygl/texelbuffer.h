@@ -27,6 +27,12 @@
 
 namespace Graphics {
 
+// Texels are stored in tiles of TEXEL_TILE_SIZE * TEXEL_TILE_SIZE, so that
+// the texels a triangle span samples from neighbouring rows share cache lines.
+#define TEXEL_TILE_SHIFT 2
+#define TEXEL_TILE_SIZE (1 << TEXEL_TILE_SHIFT)
+#define TEXEL_TILE_MASK (TEXEL_TILE_SIZE - 1)
+
 class TexelBuffer {
 public:
 	TexelBuffer(unsigned int width, unsigned int height, unsigned int textureSize);
@@ -38,13 +44,30 @@ public:
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const;
 
+	// Unfiltered texel at x, y
+	void getTexelARGB(unsigned int x, unsigned int y, uint8 &a, uint8 &r, uint8 &g, uint8 &b) const {
+		getARGBAt(tiledOffset(x, y), 0, 0, a, r, g, b);
+	}
+
+	unsigned int getWidth() const { return _width; }
+	unsigned int getHeight() const { return _height; }
+	// Memory used by the texels, in bytes
+	virtual unsigned int getMemorySize() const = 0;
+
 protected:
 	virtual void getARGBAt(
 		unsigned int pixel,
 		unsigned int ds, unsigned int dt,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const = 0;
+
+	// Index of the texel at x, y in the tiled layout
+	inline unsigned int tiledOffset(unsigned int x, unsigned int y) const {
+		return (((y >> TEXEL_TILE_SHIFT) * _paddedWidth + (x & ~TEXEL_TILE_MASK) + (y & TEXEL_TILE_MASK)) << TEXEL_TILE_SHIFT) + (x & TEXEL_TILE_MASK);
+	}
+
 	unsigned int _width, _height, _fracTextureUnit, _fracTextureMask;
+	unsigned int _paddedWidth, _paddedHeight;
 	float _widthRatio, _heightRatio;
 };
 
@@ -53,6 +76,8 @@ public:
 	NearestTexelBuffer(const PixelBuffer &buf, unsigned int width, unsigned int height, unsigned int textureSize);
 	~NearestTexelBuffer();
 
+	unsigned int getMemorySize() const override;
+
 protected:
 	void getARGBAt(
 		unsigned int pixel,
@@ -61,7 +86,7 @@ protected:
 	) const override;
 
 private:
-	PixelBuffer _buf;
+	uint32 *_texels;
 };
 
 class BilinearTexelBuffer : public TexelBuffer {
@@ -69,6 +94,8 @@ public:
 	BilinearTexelBuffer(const PixelBuffer &buf, unsigned int width, unsigned int height, unsigned int textureSize);
 	~BilinearTexelBuffer();
 
+	unsigned int getMemorySize() const override;
+
 protected:
 	void getARGBAt(
 		unsigned int pixel,
@@ -28,6 +28,7 @@
 
 // Texture Manager
 
+#include "common/debug.h"
 #include "common/endian.h"
 
 #include "graphics/tinygl/zgl.h"
@@ -87,6 +88,24 @@ static GLTexture *find_texture(GLContext *c, unsigned int h) {
 	return NULL;
 }
 
+// Replace the texel buffer of a texture level, keeping track of texture memory
+static void gl_set_texture_image(GLContext *c, GLImage *im, int level, Graphics::TexelBuffer *pixmap) {
+	if (im->pixmap) {
+		unsigned int size = im->pixmap->getMemorySize();
+		c->_textureMemoryUsed -= size;
+		if (level > 0)
+			c->_mipmapMemoryUsed -= size;
+		delete im->pixmap;
+	}
+	im->pixmap = pixmap;
+	if (pixmap) {
+		unsigned int size = pixmap->getMemorySize();
+		c->_textureMemoryUsed += size;
+		if (level > 0)
+			c->_mipmapMemoryUsed += size;
+	}
+}
+
 void free_texture(GLContext *c, int h) {
 	free_texture(c, find_texture(c, h));
 }
@@ -106,10 +125,7 @@ void free_texture(GLContext *c, GLTexture *t) {
 
 	for (int i = 0; i < MAX_TEXTURE_LEVELS; i++) {
 		im = &t->images[i];
-		if (im->pixmap) {
-			delete im->pixmap;
-			im->pixmap = nullptr;
-		}
+		gl_set_texture_image(c, im, i, nullptr);
 	}
 
 	gl_free(t);
@@ -141,6 +157,9 @@ void glInitTextures(GLContext *c) {
 	c->current_texture = find_texture(c, 0);
 	c->texture_mag_filter = TGL_LINEAR;
 	c->texture_min_filter = TGL_NEAREST_MIPMAP_LINEAR;
+	c->_textureMemoryUsed = 0;
+	c->_mipmapMemoryUsed = 0;
+	c->_textureMemoryBudget = 0;
 }
 
 void glopBindTexture(GLContext *c, GLParam *p) {
@@ -166,6 +185,122 @@ static inline const Graphics::PixelFormat formatType2PixelFormat(TGLuint format,
 	error("TinyGL texture: format 0x%04x and type 0x%04x combination not supported", format, type);
 }
 
+static inline bool isMipmapFilter(unsigned int filter) {
+	return filter == TGL_NEAREST_MIPMAP_NEAREST || filter == TGL_NEAREST_MIPMAP_LINEAR ||
+	       filter == TGL_LINEAR_MIPMAP_NEAREST || filter == TGL_LINEAR_MIPMAP_LINEAR;
+}
+
+static Graphics::TexelBuffer *createTexelBuffer(const Graphics::PixelBuffer &src, int width, int height, int textureSize, unsigned int filter) {
+	switch (filter) {
+	case TGL_LINEAR_MIPMAP_NEAREST:
+	case TGL_LINEAR_MIPMAP_LINEAR:
+	case TGL_LINEAR:
+		return new Graphics::BilinearTexelBuffer(src, width, height, textureSize);
+	default:
+		return new Graphics::NearestTexelBuffer(src, width, height, textureSize);
+	}
+}
+
+// Fill the levels after the base level of a texture, each one averaging
+// 2x2 texels of the previous one.
+static void gl_generate_mipmaps(GLContext *c, GLTexture *t, const Graphics::TexelBuffer *base) {
+	const Graphics::PixelFormat argbFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	const int texelSize = (t->mipmapFilter == TGL_LINEAR_MIPMAP_NEAREST || t->mipmapFilter == TGL_LINEAR_MIPMAP_LINEAR) ? 16 : 4;
+	int width = base->getWidth();
+	int height = base->getHeight();
+
+	uint32 *texels = new uint32[width * height];
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			uint8 a, r, g, b;
+			base->getTexelARGB(x, y, a, r, g, b);
+			texels[y * width + x] = (a << 24) | (r << 16) | (g << 8) | b;
+		}
+	}
+
+	int level = 1;
+	while ((width > 1 || height > 1) && level < MAX_TEXTURE_LEVELS) {
+		const int levelWidth = MAX(width / 2, 1);
+		const int levelHeight = MAX(height / 2, 1);
+
+		const unsigned int size = ((levelWidth + TEXEL_TILE_MASK) & ~TEXEL_TILE_MASK) * ((levelHeight + TEXEL_TILE_MASK) & ~TEXEL_TILE_MASK) * texelSize;
+		if (c->_textureMemoryBudget && c->_textureMemoryUsed + size > c->_textureMemoryBudget) {
+			debug(2, "TinyGL: Texture memory budget of %u bytes reached, not generating mipmaps past level %d", c->_textureMemoryBudget, level - 1);
+			break;
+		}
+
+		uint32 *levelTexels = new uint32[levelWidth * levelHeight];
+		for (int y = 0; y < levelHeight; y++) {
+			const uint32 *row0 = texels + MIN(y * 2, height - 1) * width;
+			const uint32 *row1 = texels + MIN(y * 2 + 1, height - 1) * width;
+			for (int x = 0; x < levelWidth; x++) {
+				const int x0 = MIN(x * 2, width - 1);
+				const int x1 = MIN(x * 2 + 1, width - 1);
+				uint32 result = 0;
+				for (int shift = 0; shift < 32; shift += 8) {
+					uint32 sum = ((row0[x0] >> shift) & 0xff) + ((row0[x1] >> shift) & 0xff) +
+					             ((row1[x0] >> shift) & 0xff) + ((row1[x1] >> shift) & 0xff);
+					result |= ((sum + 2) >> 2) << shift;
+				}
+				levelTexels[y * levelWidth + x] = result;
+			}
+		}
+
+		Graphics::PixelBuffer levelBuf(argbFormat, (byte *)levelTexels);
+		gl_set_texture_image(c, &t->images[level], level,
+			createTexelBuffer(levelBuf, levelWidth, levelHeight, c->_textureSize, t->mipmapFilter));
+		t->images[level].xsize = c->_textureSize;
+		t->images[level].ysize = c->_textureSize;
+
+		delete[] texels;
+		texels = levelTexels;
+		width = levelWidth;
+		height = levelHeight;
+		level++;
+	}
+
+	delete[] texels;
+}
+
+// Levels are only selected from with a mipmap filter, as long as they follow each other
+static void gl_count_mipmap_levels(GLTexture *t) {
+	t->mipmapLevels = 0;
+	if (t->mipmapFilter) {
+		while (t->mipmapLevels < MAX_TEXTURE_LEVELS && t->images[t->mipmapLevels].pixmap)
+			t->mipmapLevels++;
+	}
+}
+
+const Graphics::TexelBuffer *gl_get_texture_level(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2) {
+	GLTexture *t = c->current_texture;
+	const Graphics::TexelBuffer *base = t->images[0].pixmap;
+	if (!t->mipmapFilter || !base)
+		return base;
+
+	// The ratio of the texel area and the pixel area of the triangle gives
+	// the squared scale factor, one level per factor of two.
+	float texelArea = ((p1->tex_coord.X - p0->tex_coord.X) * (p2->tex_coord.Y - p0->tex_coord.Y) -
+	                   (p2->tex_coord.X - p0->tex_coord.X) * (p1->tex_coord.Y - p0->tex_coord.Y)) *
+	                  base->getWidth() * base->getHeight();
+	float pixelArea = (float)((p1->zp.x - p0->zp.x) * (p2->zp.y - p0->zp.y) -
+	                          (p2->zp.x - p0->zp.x) * (p1->zp.y - p0->zp.y));
+	if (pixelArea == 0.0f)
+		return base;
+	float scale = fabs(texelArea / pixelArea);
+
+	// Nearest level: level n is used from a scale factor of 2^(n - 0.5)
+	float threshold = 2.0f;
+	if (scale <= threshold)
+		return base;
+
+	int level = 0;
+	while (level + 1 < t->mipmapLevels && scale > threshold) {
+		level++;
+		threshold *= 4.0f;
+	}
+	return t->images[level].pixmap;
+}
+
 void glopTexImage2D(GLContext *c, GLParam *p) {
 	int target = p[1].i;
 	int level = p[2].i;
@@ -186,13 +321,16 @@ void glopTexImage2D(GLContext *c, GLParam *p) {
 	if (border != 0)
 		error("tglTexImage2D: invalid border");
 
-	c->current_texture->versionNumber++;
-	im = &c->current_texture->images[level];
+	GLTexture *t = c->current_texture;
+	t->versionNumber++;
+	im = &t->images[level];
 	im->xsize = c->_textureSize;
 	im->ysize = c->_textureSize;
-	if (im->pixmap) {
-		delete im->pixmap;
-		im->pixmap = nullptr;
+	gl_set_texture_image(c, im, level, nullptr);
+	if (level == 0) {
+		// The other levels are derived from this one
+		for (int i = 1; i < MAX_TEXTURE_LEVELS; i++)
+			gl_set_texture_image(c, &t->images[i], i, nullptr);
 	}
 	if (pixels != NULL) {
 		unsigned int filter;
@@ -201,25 +339,41 @@ void glopTexImage2D(GLContext *c, GLParam *p) {
 			filter = c->texture_mag_filter;
 		else
 			filter = c->texture_min_filter;
-		switch (filter) {
-		case TGL_LINEAR_MIPMAP_NEAREST:
-		case TGL_LINEAR_MIPMAP_LINEAR:
-		case TGL_LINEAR:
-			im->pixmap = new Graphics::BilinearTexelBuffer(
-				src,
-				width, height,
-				c->_textureSize
-			);
-			break;
-		default:
-			im->pixmap = new Graphics::NearestTexelBuffer(
-				src,
-				width, height,
-				c->_textureSize
-			);
-			break;
-		}
+		gl_set_texture_image(c, im, level, createTexelBuffer(src, width, height, c->_textureSize, filter));
 	}
+
+	// Mipmaps are generated along with the base level, so the rasterizer
+	// only has to pick a level
+	if (level == 0) {
+		t->mipmapFilter = isMipmapFilter(c->texture_min_filter) ? c->texture_min_filter : 0;
+		if (t->mipmapFilter && im->pixmap)
+			gl_generate_mipmaps(c, t, im->pixmap);
+	}
+	gl_count_mipmap_levels(t);
+}
+
+void glopGenerateMipmap(GLContext *c, GLParam *p) {
+	int target = p[1].i;
+
+	if (target != TGL_TEXTURE_2D)
+		error("tglGenerateMipmap: target not handled");
+
+	GLTexture *t = c->current_texture;
+	const Graphics::TexelBuffer *base = t->images[0].pixmap;
+	if (!base)
+		return;
+
+	// The texel buffers of the levels depend on the minification filter
+	if (isMipmapFilter(c->texture_min_filter))
+		t->mipmapFilter = c->texture_min_filter;
+	if (!t->mipmapFilter)
+		return;
+
+	t->versionNumber++;
+	for (int i = 1; i < MAX_TEXTURE_LEVELS; i++)
+		gl_set_texture_image(c, &t->images[i], i, nullptr);
+	gl_generate_mipmaps(c, t, base);
+	gl_count_mipmap_levels(t);
 }
 
 // TODO: not all tests are done
@@ -317,6 +471,17 @@ void tglGenTextures(int n, unsigned int *textures) {
 	}
 }
 
+void tglSetTextureMemoryBudget(unsigned int budget) {
+	TinyGL::GLContext *c = TinyGL::gl_get_context();
+	c->_textureMemoryBudget = budget;
+}
+
+void tglGetTextureMemoryStats(unsigned int *memoryUsed, unsigned int *mipmapMemoryUsed) {
+	TinyGL::GLContext *c = TinyGL::gl_get_context();
+	*memoryUsed = c->_textureMemoryUsed;
+	*mipmapMemoryUsed = c->_mipmapMemoryUsed;
+}
+
 void tglDeleteTextures(int n, const unsigned int *textures) {
 	TinyGL::GLContext *c = TinyGL::gl_get_context();
 	TinyGL::GLTexture *t;
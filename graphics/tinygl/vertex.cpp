@@ -188,6 +188,71 @@ static inline void gl_vertex_transform(GLContext *c, GLVertex *v) {
 	v->clip_code = gl_clipcode(v->pc.X, v->pc.Y, v->pc.Z, v->pc.W);
 }
 
+void gl_vertex_transform_batch(GLContext *c, GLVertex *v, int count) {
+	assert(!c->lighting_enabled);
+
+	const Matrix4 &m = c->matrix_model_projection;
+
+	// coords, the same operations in the same order as transform3x4(),
+	// so the results are identical
+#ifdef TINYGL_SSE2
+	const __m128 col0 = _mm_setr_ps(m._m[0][0], m._m[1][0], m._m[2][0], m._m[3][0]);
+	const __m128 col1 = _mm_setr_ps(m._m[0][1], m._m[1][1], m._m[2][1], m._m[3][1]);
+	const __m128 col2 = _mm_setr_ps(m._m[0][2], m._m[1][2], m._m[2][2], m._m[3][2]);
+	const __m128 col3 = _mm_setr_ps(m._m[0][3], m._m[1][3], m._m[2][3], m._m[3][3]);
+	for (int i = 0; i < count; i++) {
+		const Vector4 &coord = v[i].coord;
+		__m128 pc = _mm_mul_ps(_mm_set1_ps(coord.X), col0);
+		pc = _mm_add_ps(pc, _mm_mul_ps(_mm_set1_ps(coord.Y), col1));
+		pc = _mm_add_ps(pc, _mm_mul_ps(_mm_set1_ps(coord.Z), col2));
+		pc = _mm_add_ps(pc, col3);
+		_mm_storeu_ps(v[i].pc._v, pc);
+	}
+#else
+	for (int i = 0; i < count; i++) {
+		m.transform3x4(v[i].coord, v[i].pc);
+	}
+#endif
+	if (c->matrix_model_projection_no_w_transform) {
+		for (int i = 0; i < count; i++) {
+			v[i].pc.W = m._m[3][3];
+		}
+	}
+
+	// clip codes
+	for (int i = 0; i < count; i++) {
+		const Vector4 &pc = v[i].pc;
+		v[i].clip_code = gl_clipcode(pc.X, pc.Y, pc.Z, pc.W);
+	}
+
+	// no eye coordinates needed, no normal, and the mapping to the viewport
+	for (int i = 0; i < count; i++) {
+		v[i].normal.X = v[i].normal.Y = v[i].normal.Z = 0;
+		v[i].ec.X = v[i].ec.Y = v[i].ec.Z = v[i].ec.W = 0;
+		if (v[i].clip_code == 0)
+			gl_transform_to_viewport(c, &v[i]);
+	}
+}
+
+void gl_reserve_vertices(GLContext *c, int count) {
+	if (count <= c->vertex_max)
+		return;
+
+	// quick fix to avoid crashes on large polygons
+	int vertexMax = c->vertex_max;
+	while (vertexMax < count)
+		vertexMax <<= 1;    // just double size
+
+	GLVertex *newarray = (GLVertex *)gl_malloc(sizeof(GLVertex) * vertexMax);
+	if (!newarray) {
+		error("unable to allocate GLVertex array.");
+	}
+	memcpy(newarray, c->vertex, c->vertex_n * sizeof(GLVertex));
+	gl_free(c->vertex);
+	c->vertex = newarray;
+	c->vertex_max = vertexMax;
+}
+
 void glopVertex(GLContext *c, GLParam *p) {
 	GLVertex *v;
 	int n, cnt;
@@ -199,18 +264,7 @@ void glopVertex(GLContext *c, GLParam *p) {
 	cnt++;
 	c->vertex_cnt = cnt;
 
-	// quick fix to avoid crashes on large polygons
-	if (n >= c->vertex_max) {
-		GLVertex *newarray;
-		c->vertex_max <<= 1;    // just double size
-		newarray = (GLVertex *)gl_malloc(sizeof(GLVertex) * c->vertex_max);
-		if (!newarray) {
-			error("unable to allocate GLVertex array.");
-		}
-		memcpy(newarray, c->vertex, n * sizeof(GLVertex));
-		gl_free(c->vertex);
-		c->vertex = newarray;
-	}
+	gl_reserve_vertices(c, n + 1);
 	// new vertex entry
 	v = &c->vertex[n];
 	n++;
@@ -34,6 +34,11 @@
 #include "graphics/tinygl/gl.h"
 #include "common/rect.h"
 
+#if defined(__SSE2__)
+#define TINYGL_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace TinyGL {
 
 // Z buffer
@@ -159,6 +164,48 @@ struct FrameBuffer {
 		return false;
 	}
 
+	// Check whether any of the 4 pixels starting at pz passes the depth test,
+	// z being the depth of the first pixel and dzdx the step between pixels.
+	FORCEINLINE bool compareDepthQuad(unsigned int z, int dzdx, const unsigned int *pz) {
+		if (!_depthTestEnabled)
+			return true;
+
+#ifdef TINYGL_SSE2
+		// SSE2 only has signed comparisons, flipping the sign bit of both
+		// operands gives the result of the unsigned ones
+		const __m128i bias = _mm_set1_epi32((int)0x80000000);
+		const __m128i zSrc = _mm_xor_si128(_mm_set_epi32(z + 3 * dzdx, z + 2 * dzdx, z + dzdx, z), bias);
+		const __m128i zDst = _mm_xor_si128(_mm_loadu_si128((const __m128i *)pz), bias);
+
+		switch (_depthFunc) {
+		case TGL_NEVER:
+			return false;
+		case TGL_LESS:
+			return _mm_movemask_epi8(_mm_cmplt_epi32(zDst, zSrc)) != 0;
+		case TGL_EQUAL:
+			return _mm_movemask_epi8(_mm_cmpeq_epi32(zDst, zSrc)) != 0;
+		case TGL_LEQUAL:
+			return _mm_movemask_epi8(_mm_cmpgt_epi32(zDst, zSrc)) != 0xffff;
+		case TGL_GREATER:
+			return _mm_movemask_epi8(_mm_cmpgt_epi32(zDst, zSrc)) != 0;
+		case TGL_NOTEQUAL:
+			return _mm_movemask_epi8(_mm_cmpeq_epi32(zDst, zSrc)) != 0xffff;
+		case TGL_GEQUAL:
+			return _mm_movemask_epi8(_mm_cmplt_epi32(zDst, zSrc)) != 0xffff;
+		default:
+			return true;
+		}
+#else
+		for (int i = 0; i < 4; i++) {
+			unsigned int zSrc = z + i * dzdx;
+			unsigned int zDst = pz[i];
+			if (compareDepth(zSrc, zDst))
+				return true;
+		}
+		return false;
+#endif
+	}
+
 	FORCEINLINE bool checkAlphaTest(byte aSrc) {
 		if (!_alphaTestEnabled)
 			return true;
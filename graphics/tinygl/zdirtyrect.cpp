@@ -30,6 +30,7 @@
 #include "graphics/tinygl/zgl.h"
 #include "graphics/tinygl/gl.h"
 #include "common/debug.h"
+#include "common/hashmap.h"
 #include "common/math.h"
 
 namespace TinyGL {
@@ -122,32 +123,73 @@ static inline void _appendDirtyRectangle(const Graphics::DrawCall &call, Common:
 static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 	typedef Common::List<Graphics::DrawCall *>::const_iterator DrawCallIterator;
 	typedef Common::List<TinyGL::DirtyRectangle>::iterator RectangleIterator;
+	typedef Common::HashMap<uint32, Common::Array<int> > DrawCallHashMap;
 
 	Common::List<DirtyRectangle> rectangles;
 
-	DrawCallIterator itFrame = c->_drawCallsQueue.begin();
-	DrawCallIterator endFrame = c->_drawCallsQueue.end();
-	DrawCallIterator itPrevFrame = c->_previousFrameDrawCallsQueue.begin();
-	DrawCallIterator endPrevFrame = c->_previousFrameDrawCallsQueue.end();
-
-	// Compare draw calls.
-	for ( ; itPrevFrame != endPrevFrame && itFrame != endFrame;
-		++itPrevFrame, ++itFrame) {
-			const Graphics::DrawCall &currentCall = **itFrame;
-			const Graphics::DrawCall &previousCall = **itPrevFrame;
+	// Index the draw calls of the previous frame by hash.
+	Common::Array<Graphics::DrawCall *> previousCalls;
+	DrawCallHashMap previousCallsByHash;
+	for (DrawCallIterator it = c->_previousFrameDrawCallsQueue.begin(); it != c->_previousFrameDrawCallsQueue.end(); ++it) {
+		previousCallsByHash[(*it)->getHash()].push_back(previousCalls.size());
+		previousCalls.push_back(*it);
+	}
+	Common::Array<bool> previousMatched(previousCalls.size(), false);
 
-			if (previousCall != currentCall) {
-				_appendDirtyRectangle(previousCall, rectangles, 255, 255, 255);
-				_appendDirtyRectangle(currentCall, rectangles, 255, 0, 0);
+	// Match every draw call with an equal one of the previous frame, wherever it
+	// was in the queue. Calls without a match need to be redrawn.
+	Common::Array<Graphics::DrawCall *> currentCalls;
+	Common::Array<int> currentMatches;
+	for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
+		const Graphics::DrawCall &currentCall = **it;
+		int match = -1;
+
+		DrawCallHashMap::const_iterator candidates = previousCallsByHash.find(currentCall.getHash());
+		if (candidates != previousCallsByHash.end()) {
+			for (uint i = 0; i < candidates->_value.size(); i++) {
+				int candidate = candidates->_value[i];
+				if (!previousMatched[candidate] && *previousCalls[candidate] == currentCall) {
+					previousMatched[candidate] = true;
+					match = candidate;
+					break;
+				}
 			}
+		}
+
+		if (match < 0)
+			_appendDirtyRectangle(currentCall, rectangles, 255, 0, 0);
+		currentCalls.push_back(*it);
+		currentMatches.push_back(match);
 	}
 
-	for ( ; itPrevFrame != endPrevFrame; ++itPrevFrame) {
-		_appendDirtyRectangle(**itPrevFrame, rectangles, 255, 255, 255);
+	for (uint i = 0; i < previousCalls.size(); i++) {
+		if (!previousMatched[i])
+			_appendDirtyRectangle(*previousCalls[i], rectangles, 255, 255, 255);
 	}
 
-	for ( ; itFrame != endFrame; ++itFrame) {
-		_appendDirtyRectangle(**itFrame, rectangles, 255, 0, 0);
+	// Matched calls which swapped order only give the same pixels when they don't
+	// overlap. For every swapped pair the later call is the one found behind the
+	// highest previous position seen so far, redraw it when it overlaps.
+	int reusedDrawCalls = 0;
+	int highestMatch = -1;
+	for (uint i = 0; i < currentCalls.size(); i++) {
+		if (currentMatches[i] < 0)
+			continue;
+		reusedDrawCalls++;
+
+		if (currentMatches[i] > highestMatch) {
+			highestMatch = currentMatches[i];
+			continue;
+		}
+
+		const Common::Rect region = currentCalls[i]->getDirtyRegion();
+		for (uint j = 0; j < i; j++) {
+			if (currentMatches[j] > currentMatches[i] && region.intersects(currentCalls[j]->getDirtyRegion())) {
+				_appendDirtyRectangle(*currentCalls[i], rectangles, 0, 0, 255);
+				reusedDrawCalls--;
+				break;
+			}
+		}
 	}
 
 	// This loop increases outer rectangle coordinates to favor merging of adjacent rectangles.
@@ -189,10 +231,20 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 		}
 	}
 
+	int redrawnPixels = 0;
 	for (RectangleIterator it1 = rectangles.begin(); it1 != rectangles.end(); ++it1) {
 		(*it1).rectangle.clip(c->renderRect);
+		// The merged rectangles don't overlap
+		redrawnPixels += (*it1).rectangle.width() * (*it1).rectangle.height();
 	}
 
+	c->_redrawnPixels = redrawnPixels;
+	c->_totalPixels = c->renderRect.width() * c->renderRect.height();
+	c->_reusedDrawCalls = reusedDrawCalls;
+	c->_totalDrawCalls = currentCalls.size();
+	debug(6, "TinyGL: Redrew %d%% of the screen, %d of %d draw calls unchanged",
+	      c->_totalPixels ? redrawnPixels * 100 / c->_totalPixels : 0, reusedDrawCalls, c->_totalDrawCalls);
+
 	if (!rectangles.empty()) {
 		// Execute draw calls.
 		for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
@@ -206,9 +258,9 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 		}
 #if TGL_DIRTY_RECT_SHOW
 		// Draw debug rectangles.
-		// Note: white rectangles are rectangle that contained other rectangles
-		// blue rectangles are rectangle merged from other rectangles
-		// red rectangles are original dirty rects
+		// Note: white rectangles are regions of calls of the previous frame only
+		// blue rectangles are regions of calls drawn in a different order
+		// red rectangles are regions of new calls
 
 		bool blendingEnabled = c->fb->isBlendingEnabled();
 		bool alphaTestEnabled = c->fb->isAlphaTestEnabled();
@@ -239,9 +291,17 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 	c->_drawCallAllocator[c->_currentAllocatorIndex].reset();
 }
 
+static void tglCountFullRedraw(TinyGL::GLContext *c) {
+	c->_redrawnPixels = c->_totalPixels = c->renderRect.width() * c->renderRect.height();
+	c->_reusedDrawCalls = 0;
+	c->_totalDrawCalls = c->_drawCallsQueue.size();
+}
+
 static void tglPresentBufferSimple(TinyGL::GLContext *c) {
 	typedef Common::List<Graphics::DrawCall *>::const_iterator DrawCallIterator;
 
+	tglCountFullRedraw(c);
+
 	for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
 		(*it)->execute(true);
 		delete *it;
@@ -267,6 +327,31 @@ void tglPresentBuffer() {
 
 namespace Graphics {
 
+// FNV-1a, one word at a time
+static inline uint32 hashValue(uint32 hash, uint32 value) {
+	return (hash ^ value) * 16777619;
+}
+
+static inline uint32 hashFloat(uint32 hash, float value) {
+	// Equal floats need equal hashes, adding zero turns -0.0f into 0.0f
+	value += 0.0f;
+	uint32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return hashValue(hash, bits);
+}
+
+static inline uint32 hashPointer(uint32 hash, const void *ptr) {
+	return hashValue(hash, (uint32)(uintptr)ptr);
+}
+
+static inline uint32 hashVector(uint32 hash, const TinyGL::Vector4 &vector) {
+	for (int i = 0; i < 4; i++)
+		hash = hashFloat(hash, vector._v[i]);
+	return hash;
+}
+
+static const uint32 kHashSeed = 2166136261u;
+
 bool DrawCall::operator==(const DrawCall &other) const {
 	if (_type == other._type) {
 		switch (_type) {
@@ -298,6 +383,39 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	if (c->_enableDirtyRectangles) {
 		computeDirtyRegion();
 	}
+	if (c->_enableDirtyRectangles) {
+		_hash = computeHash();
+	}
+}
+
+uint32 RasterizationDrawCall::computeHash() const {
+	// Only what is cheap and sufficient to tell most calls apart,
+	// the few collisions are sorted out by operator==
+	uint32 hash = hashValue(kHashSeed, _vertexCount);
+	hash = hashPointer(hash, (const void *)_drawTriangleFront);
+	hash = hashPointer(hash, (const void *)_drawTriangleBack);
+
+	hash = hashValue(hash, _state.beginType);
+	hash = hashValue(hash, _state.cullFaceEnabled);
+	hash = hashValue(hash, _state.depthFunction);
+	hash = hashValue(hash, _state.depthWrite);
+	hash = hashValue(hash, _state.texture2DEnabled);
+	hash = hashValue(hash, _state.enableBlending);
+	hash = hashValue(hash, _state.sfactor);
+	hash = hashValue(hash, _state.dfactor);
+	hash = hashValue(hash, _state.alphaTest);
+	hash = hashPointer(hash, _state.texture);
+	if (_state.texture)
+		hash = hashValue(hash, _state.textureVersion);
+
+	for (int i = 0; i < _vertexCount; i++) {
+		const TinyGL::GLVertex &v = _vertex[i];
+		hash = hashValue(hash, v.clip_code);
+		hash = hashVector(hash, v.coord);
+		hash = hashVector(hash, v.color);
+		hash = hashVector(hash, v.tex_coord);
+	}
+	return hash;
 }
 
 void RasterizationDrawCall::computeDirtyRegion() {
@@ -399,11 +517,16 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 		break;
 	case TGL_QUADS:
 		for(int i = 0; i < cnt; i += 4) {
+			// Hide the diagonal, the vertices are restored so the call still
+			// compares equal to the same quads in the next frame
+			int edgeFlag0 = c->vertex[i + 0].edge_flag;
+			int edgeFlag2 = c->vertex[i + 2].edge_flag;
 			c->vertex[i + 2].edge_flag = 0;
 			gl_draw_triangle(c, &c->vertex[i], &c->vertex[i + 1], &c->vertex[i + 2]);
-			c->vertex[i + 2].edge_flag = 1;
+			c->vertex[i + 2].edge_flag = edgeFlag2;
 			c->vertex[i + 0].edge_flag = 0;
 			gl_draw_triangle(c, &c->vertex[i], &c->vertex[i + 2], &c->vertex[i + 3]);
+			c->vertex[i + 0].edge_flag = edgeFlag0;
 		}
 		break;
 	case TGL_QUAD_STRIP:
@@ -525,9 +648,41 @@ BlittingDrawCall::BlittingDrawCall(Graphics::BlitImage *image, const BlitTransfo
 	tglIncBlitImageRef(image);
 	_blitState = captureState();
 	_imageVersion = tglGetBlitImageVersion(image);
-	if (TinyGL::gl_get_context()->_enableDirtyRectangles) {
+	TinyGL::GLContext *c = TinyGL::gl_get_context();
+	if (c->_enableDirtyRectangles) {
 		computeDirtyRegion();
 	}
+	if (c->_enableDirtyRectangles) {
+		_hash = computeHash();
+	}
+}
+
+uint32 BlittingDrawCall::computeHash() const {
+	uint32 hash = hashValue(kHashSeed, _mode);
+	hash = hashPointer(hash, _image);
+	hash = hashValue(hash, _imageVersion);
+
+	const Common::Rect &src = _transform._sourceRectangle;
+	const Common::Rect &dst = _transform._destinationRectangle;
+	hash = hashValue(hash, src.left);
+	hash = hashValue(hash, src.top);
+	hash = hashValue(hash, src.right);
+	hash = hashValue(hash, src.bottom);
+	hash = hashValue(hash, dst.left);
+	hash = hashValue(hash, dst.top);
+	hash = hashValue(hash, dst.right);
+	hash = hashValue(hash, dst.bottom);
+	hash = hashValue(hash, _transform._rotation);
+	hash = hashFloat(hash, _transform._aTint);
+	hash = hashFloat(hash, _transform._rTint);
+	hash = hashFloat(hash, _transform._gTint);
+	hash = hashFloat(hash, _transform._bTint);
+
+	hash = hashValue(hash, _blitState.enableBlending);
+	hash = hashValue(hash, _blitState.sfactor);
+	hash = hashValue(hash, _blitState.dfactor);
+	hash = hashValue(hash, _blitState.alphaTest);
+	return hash;
 }
 
 BlittingDrawCall::~BlittingDrawCall() {
@@ -608,6 +763,9 @@ void BlittingDrawCall::computeDirtyRegion() {
 	}
 	if (blitWidth == 0 || blitHeight == 0) {
 		_dirtyRegion = Common::Rect();
+	} else if (_transform._rotation != 0) {
+		// Rotated images may cover pixels outside of the destination rectangle
+		_dirtyRegion = TinyGL::gl_get_context()->renderRect;
 	} else {
 		_dirtyRegion = Common::Rect(
 			_transform._destinationRectangle.left,
@@ -633,6 +791,19 @@ ClearBufferDrawCall::ClearBufferDrawCall(bool clearZBuffer, int zValue, bool cle
 	if (c->_enableDirtyRectangles) {
 		_dirtyRegion = c->renderRect;
 	}
+	if (c->_enableDirtyRectangles) {
+		_hash = computeHash();
+	}
+}
+
+uint32 ClearBufferDrawCall::computeHash() const {
+	uint32 hash = hashValue(kHashSeed, _clearZBuffer);
+	hash = hashValue(hash, _clearColorBuffer);
+	hash = hashValue(hash, _zValue);
+	hash = hashValue(hash, _rValue);
+	hash = hashValue(hash, _gValue);
+	hash = hashValue(hash, _bValue);
+	return hash;
 }
 
 void ClearBufferDrawCall::execute(bool restoreState) const {
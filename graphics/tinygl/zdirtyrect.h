@@ -54,7 +54,7 @@ public:
 		DrawCall_Clear
 	};
 
-	DrawCall(DrawCallType type) : _type(type) { }
+	DrawCall(DrawCallType type) : _hash(0), _type(type) { }
 	virtual ~DrawCall() { }
 	bool operator==(const DrawCall &other) const;
 	bool operator!=(const DrawCall &other) const {
@@ -64,8 +64,11 @@ public:
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const = 0;
 	DrawCallType getType() const { return _type; }
 	virtual const Common::Rect getDirtyRegion() const { return _dirtyRegion; }
+	// Hash of the state and geometry of the call, equal calls have equal hashes
+	uint32 getHash() const { return _hash; }
 protected:
 	Common::Rect _dirtyRegion;
+	uint32 _hash;
 private:
 	DrawCallType _type;
 };
@@ -84,6 +87,7 @@ public:
 
 	void operator delete(void *p) { }
 private:
+	uint32 computeHash() const;
 	bool _clearZBuffer, _clearColorBuffer;
 	int _rValue, _gValue, _bValue, _zValue;
 };
@@ -104,6 +108,7 @@ public:
 	void operator delete(void *p) { }
 private:
 	void computeDirtyRegion();
+	uint32 computeHash() const;
 	typedef void (*gl_draw_triangle_func_ptr)(TinyGL::GLContext *c, TinyGL::GLVertex *p0, TinyGL::GLVertex *p1, TinyGL::GLVertex *p2);
 	int _vertexCount;
 	TinyGL::GLVertex *_vertex;
@@ -169,6 +174,7 @@ public:
 	void operator delete(void *p) { }
 private:
 	void computeDirtyRegion();
+	uint32 computeHash() const;
 	BlitImage *_image;
 	BlitTransform _transform;
 	BlittingMode _mode;
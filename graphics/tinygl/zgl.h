@@ -185,6 +185,11 @@ struct GLImage {
 
 struct GLTexture {
 	GLImage images[MAX_TEXTURE_LEVELS];
+	// Number of levels the rasterizer selects from, 1 when not mipmapped
+	int mipmapLevels;
+	// Minification filter the base level was uploaded with if it is a
+	// mipmap filter, 0 otherwise
+	unsigned int mipmapFilter;
 	unsigned int handle;
 	int versionNumber;
 	struct GLTexture *next, *prev;
@@ -263,6 +268,11 @@ struct GLContext {
 	// Internal texture size
 	int _textureSize;
 
+	// Memory used by the texel buffers, and the part of it used by mipmaps
+	unsigned int _textureMemoryUsed, _mipmapMemoryUsed;
+	// No mipmaps are generated beyond this, 0 for no limit
+	unsigned int _textureMemoryBudget;
+
 	// lights
 	GLLight lights[T_MAX_LIGHTS];
 	GLLight *first_light;
@@ -388,6 +398,10 @@ struct GLContext {
 
 	bool _enableDirtyRectangles;
 
+	// Statistics of the last presented frame
+	int _redrawnPixels, _totalPixels;
+	int _reusedDrawCalls, _totalDrawCalls;
+
 	// blit test
 	Common::List<Graphics::BlitImage *> _blitImages;
 
@@ -402,6 +416,12 @@ extern GLContext *gl_ctx;
 
 void gl_add_op(GLParam *p);
 
+// vertex.c
+// Transform vertices, compute their clip codes and map them to the viewport, lighting must be disabled
+void gl_vertex_transform_batch(GLContext *c, GLVertex *v, int count);
+// Make sure the GLVertex array can hold count vertices
+void gl_reserve_vertices(GLContext *c, int count);
+
 // clip.c
 void gl_transform_to_viewport(GLContext *c, GLVertex *v);
 void gl_draw_triangle(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2);
@@ -426,6 +446,8 @@ void glEndTextures(GLContext *c);
 GLTexture *alloc_texture(GLContext *c, int h);
 void free_texture(GLContext *c, int h);
 void free_texture(GLContext *c, GLTexture *t);
+// Texture level of the current texture to rasterize a triangle with
+const Graphics::TexelBuffer *gl_get_texture_level(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2);
 
 // image_util.c
 void gl_resizeImage(Graphics::PixelBuffer &dest, int xsize_dest, int ysize_dest,
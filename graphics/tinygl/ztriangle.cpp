@@ -360,8 +360,14 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
+			// Scanlines below the scissor rectangle can't produce any pixel, the ones
+			// above it only need their edges to be stepped. The shadow mask ignores
+			// the scissor rectangle and is always drawn entirely.
+			if (kEnableScissor && kDrawLogic != DRAW_SHADOW_MASK && y >= _clipRectangle.bottom)
+				return;
+
 			int x = x1;
-			{
+			if (!kEnableScissor || kDrawLogic == DRAW_SHADOW_MASK || y >= _clipRectangle.top) {
 				if (kDrawLogic == DRAW_DEPTH_ONLY ||
 						(kDrawLogic == DRAW_FLAT && !(kInterpST || kInterpSTZ))) {
 					int pp;
@@ -382,6 +388,16 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						a = a1;
 					}
 					while (n >= 3) {
+						if (kInterpZ && !compareDepthQuad(z, dzdx, pz)) {
+							// None of the 4 pixels is visible
+							z += 4 * dzdx;
+							buf += 4;
+							pz += 4;
+							pp += 4;
+							n -= 4;
+							x += 4;
+							continue;
+						}
 						if (kDrawLogic == DRAW_DEPTH_ONLY) {
 							putPixelDepth<kDepthWrite, kEnableScissor>(this, buf, pz, 0, x, y, z, dzdx);
 							putPixelDepth<kDepthWrite, kEnableScissor>(this, buf, pz, 1, x, y, z, dzdx);
@@ -486,6 +502,19 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					b = b1;
 					a = a1;
 					while (n >= 3) {
+						if (!compareDepthQuad(z, dzdx, pz)) {
+							// None of the 4 pixels is visible
+							z += 4 * dzdx;
+							r += 4 * drdx;
+							g += 4 * dgdx;
+							b += 4 * dbdx;
+							a += 4 * dadx;
+							pz += 4;
+							buf += 4;
+							n -= 4;
+							x += 4;
+							continue;
+						}
 						putPixelSmooth<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, pz, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx);
 						putPixelSmooth<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, pz, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx);
 						putPixelSmooth<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, pz, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx);
@@ -536,9 +565,25 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 							fz += fndzdx;
 							zinv = (float)(1.0 / fz);
 						}
-						for (int _a = 0; _a < NB_INTERP; _a++) {
-							putPixelTextureMappingPerspective<kDepthWrite, kInterpRGB, kDrawLogic == DRAW_SMOOTH, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, texture, wrapS, wrapT,
-							                           pz, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+						// NB_INTERP is a multiple of 4, pixels are depth tested 4 at a time
+						// to skip the texel fetches of hidden ones
+						for (int _q = 0; _q < NB_INTERP; _q += 4) {
+							if (!compareDepthQuad(z, dzdx, pz + _q)) {
+								z += 4 * dzdx;
+								s += 4 * dsdx;
+								t += 4 * dtdx;
+								if (kDrawLogic == DRAW_SMOOTH) {
+									a += 4 * dadx;
+									r += 4 * drdx;
+									g += 4 * dgdx;
+									b += 4 * dbdx;
+								}
+								continue;
+							}
+							for (int _a = _q; _a < _q + 4; _a++) {
+								putPixelTextureMappingPerspective<kDepthWrite, kInterpRGB, kDrawLogic == DRAW_SMOOTH, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, texture, wrapS, wrapT,
+								                           pz, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+							}
 						}
 						pz += NB_INTERP;
 						buf += NB_INTERP;
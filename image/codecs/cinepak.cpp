@@ -58,74 +58,49 @@ inline uint16 createDitherTableIndex(const byte *clipTable, byte y, int8 u, int8
 }
 
 /**
- * Put a raw pixel to the destination surface
- */
-template<typename PixelInt>
-inline void putPixelRaw(PixelInt *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = convertYUVToColor(clipTable, format, y, u, v);
-}
-
-/**
- * Specialized putPixelRaw for palettized 8bpp output
- */
-template<>
-inline void putPixelRaw(byte *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = y;
-}
-
-/**
- * The default codebook converter: raw output.
+ * The default codebook converter: raw output, using the codebook entries
+ * already converted to the output pixel format.
  */
 struct CodebookConverterRaw {
 	template<typename PixelInt>
 	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
 		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
+		const PixelInt color0 = codebook.rgb[0];
+		const PixelInt color1 = codebook.rgb[1];
+		const PixelInt color2 = codebook.rgb[2];
+		const PixelInt color3 = codebook.rgb[3];
+
+		rows[0][0] = rows[0][1] = rows[1][0] = rows[1][1] = color0;
+		rows[0][2] = rows[0][3] = rows[1][2] = rows[1][3] = color1;
+		rows[2][0] = rows[2][1] = rows[3][0] = rows[3][1] = color2;
+		rows[2][2] = rows[2][3] = rows[3][2] = rows[3][3] = color3;
 	}
 
 	template<typename PixelInt>
 	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
 		const CinepakCodebook &codebook1 = strip.v4_codebook[codebookIndex[0]];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook1.y[0], codebook1.u, codebook1.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook1.y[1], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook1.y[2], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook1.y[3], codebook1.u, codebook1.v);
+		rows[0][0] = codebook1.rgb[0];
+		rows[0][1] = codebook1.rgb[1];
+		rows[1][0] = codebook1.rgb[2];
+		rows[1][1] = codebook1.rgb[3];
 
 		const CinepakCodebook &codebook2 = strip.v4_codebook[codebookIndex[1]];
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook2.y[0], codebook2.u, codebook2.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook2.y[1], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook2.y[2], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook2.y[3], codebook2.u, codebook2.v);
+		rows[0][2] = codebook2.rgb[0];
+		rows[0][3] = codebook2.rgb[1];
+		rows[1][2] = codebook2.rgb[2];
+		rows[1][3] = codebook2.rgb[3];
 
 		const CinepakCodebook &codebook3 = strip.v4_codebook[codebookIndex[2]];
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook3.y[0], codebook3.u, codebook3.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook3.y[1], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook3.y[2], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook3.y[3], codebook3.u, codebook3.v);
+		rows[2][0] = codebook3.rgb[0];
+		rows[2][1] = codebook3.rgb[1];
+		rows[3][0] = codebook3.rgb[2];
+		rows[3][1] = codebook3.rgb[3];
 
 		const CinepakCodebook &codebook4 = strip.v4_codebook[codebookIndex[3]];
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook4.y[0], codebook4.u, codebook4.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook4.y[1], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook4.y[2], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook4.y[3], codebook4.u, codebook4.v);
+		rows[2][2] = codebook4.rgb[0];
+		rows[2][3] = codebook4.rgb[1];
+		rows[3][2] = codebook4.rgb[2];
+		rows[3][3] = codebook4.rgb[3];
 	}
 };
 
@@ -511,12 +486,25 @@ void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 		memset(codebook[i].y, 0, 4);
 		codebook[i].u = 0;
 		codebook[i].v = 0;
+		convertCodebook(codebook[i]);
 
 		if (_ditherType == kDitherTypeQT)
 			ditherCodebookQT(strip, codebookType, i);
 	}
 }
 
+void CinepakDecoder::convertCodebook(CinepakCodebook &codebook) const {
+	// Convert the entry once here instead of for every pixel it is used for
+	if (_pixelFormat.bytesPerPixel == 1) {
+		// Palettized output
+		for (int i = 0; i < 4; i++)
+			codebook.rgb[i] = codebook.y[i];
+	} else {
+		for (int i = 0; i < 4; i++)
+			codebook.rgb[i] = convertYUVToColor(_clipTable, _pixelFormat, codebook.y[i], codebook.u, codebook.v);
+	}
+}
+
 void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize) {
 	CinepakCodebook *codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook : _curFrame.strips[strip].v4_codebook;
 
@@ -553,6 +541,8 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 			// Dither the codebook if we're dithering for QuickTime
 			if (_ditherType == kDitherTypeQT)
 				ditherCodebookQT(strip, codebookType, i);
+			else if (!_ditherPalette)
+				convertCodebook(codebook[i]);
 		}
 	}
 }
@@ -39,6 +39,9 @@ struct CinepakCodebook {
 	// These are not in the normal YUV colorspace, but in the Cinepak YUV colorspace instead.
 	byte y[4]; // [0, 255]
 	int8 u, v; // [-128, 127]
+
+	// The four luma samples converted to the output pixel format
+	uint32 rgb[4];
 };
 
 struct CinepakStrip {
@@ -95,6 +98,7 @@ private:
 	DitherType _ditherType;
 
 	void initializeCodebook(uint16 strip, byte codebookType);
+	void convertCodebook(CinepakCodebook &codebook) const;
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
 	void decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 
@@ -71,10 +71,24 @@ inline uint16 makeQuickTimeDitherColor(byte r, byte g, byte b) {
 	return ((r & 0xF8) << 6) | ((g & 0xF8) << 1) | (b >> 4);
 }
 
+// The last generated QuickTime dither table. Videos of a game are usually
+// all dithered to the same palette, so this avoids regenerating the table
+// for every video (and every codec instance of a video).
+byte s_ditherTableCache[0x10000];
+byte s_ditherTableCachePalette[256 * 3];
+uint s_ditherTableCacheColorCount = 0;
+
 } // End of anonymous namespace
 
 byte *Codec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 	byte *buf = new byte[0x10000];
+
+	if (colorCount != 0 && colorCount == s_ditherTableCacheColorCount &&
+			!memcmp(palette, s_ditherTableCachePalette, colorCount * 3)) {
+		memcpy(buf, s_ditherTableCache, 0x10000);
+		return buf;
+	}
+
 	memset(buf, 0, 0x10000);
 
 	Common::List<uint16> checkQueue;
@@ -193,6 +207,12 @@ byte *Codec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 		}
 	}
 
+	if (colorCount <= 256) {
+		memcpy(s_ditherTableCache, buf, 0x10000);
+		memcpy(s_ditherTableCachePalette, palette, colorCount * 3);
+		s_ditherTableCacheColorCount = colorCount;
+	}
+
 	return buf;
 }
 
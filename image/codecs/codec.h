@@ -113,6 +113,8 @@ public:
 
 	/**
 	 * Create a dither table, as used by QuickTime codecs.
+	 * The last table generated is kept, so creating a table for the same
+	 * palette again only costs a copy. The caller owns the returned table.
 	 */
 	static byte *createQuickTimeDitherTable(const byte *palette, uint colorCount);
 };
@@ -28,6 +28,11 @@
 
 #include "image/codecs/indeo/indeo_dsp.h"
 
+#if defined(__SSE2__)
+#define INDEO_DSP_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Image {
 namespace Indeo {
 
@@ -530,6 +535,9 @@ void IndeoDSP::ffIviPutDcPixel8x8(const int32 *in, int16 *out, uint32 pitch,
 		memset(out, 0, 8 * sizeof(out[0]));
 }
 
+// The scalar motion compensation is always compiled. It is the
+// implementation used without SSE2, and the reference the SIMD version
+// is tested against.
 #define IVI_MC_TEMPLATE(size, suffix, OP) \
 static void iviMc ## size ##x## size ## suffix(int16 *buf, \
 												 uint32 dpitch, \
@@ -568,14 +576,14 @@ static void iviMc ## size ##x## size ## suffix(int16 *buf, \
 	} \
 } \
 \
-void IndeoDSP::ffIviMc ## size ##x## size ## suffix(int16 *buf, const int16 *refBuf, \
+void IndeoDSP::ffIviMc ## size ##x## size ## suffix ## C(int16 *buf, const int16 *refBuf, \
 											 uint32 pitch, int mcType) \
 { \
 	iviMc ## size ##x## size ## suffix(buf, pitch, refBuf, pitch, mcType); \
 }
 
 #define IVI_MC_AVG_TEMPLATE(size, suffix, OP) \
-void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
+void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix ## C(int16 *buf, \
 												 const int16 *refBuf, \
 												 const int16 *refBuf2, \
 												 uint32 pitch, \
@@ -604,5 +612,144 @@ IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD)
 IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT)
 IVI_MC_AVG_TEMPLATE(4, Delta,   OP_ADD)
 
+#ifdef INDEO_DSP_SSE2
+
+/**
+ * load/store one row of a 8x8 (full register) or 4x4 (lower half) block
+ */
+template<int size>
+static inline __m128i mcLoadRow(const int16 *src) {
+	if (size == 8)
+		return _mm_loadu_si128((const __m128i *)src);
+	return _mm_loadl_epi64((const __m128i *)src);
+}
+
+template<int size>
+static inline void mcStoreRow(int16 *dst, __m128i val) {
+	if (size == 8)
+		_mm_storeu_si128((__m128i *)dst, val);
+	else
+		_mm_storel_epi64((__m128i *)dst, val);
+}
+
+template<int size, bool add>
+static inline void mcWriteRow(int16 *dst, __m128i val) {
+	if (add)
+		val = _mm_add_epi16(mcLoadRow<size>(dst), val);
+	mcStoreRow<size>(dst, val);
+}
+
+/**
+ * (a + b) >> 1 computed on 16-bit lanes without intermediate overflow
+ */
+static inline __m128i mcHalfpel2(__m128i a, __m128i b) {
+	__m128i carry = _mm_and_si128(_mm_and_si128(a, b), _mm_set1_epi16(1));
+	return _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 1), _mm_srai_epi16(b, 1)), carry);
+}
+
+/**
+ * (a + b + c + d) >> 2, widened to 32-bit lanes. The result always fits
+ * into 16 bits, so the saturating pack is exact.
+ */
+static inline __m128i mcHalfpel4(__m128i a, __m128i b, __m128i c, __m128i d) {
+#define WIDEN_LO(x) _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16)
+#define WIDEN_HI(x) _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16)
+	__m128i lo = _mm_add_epi32(_mm_add_epi32(WIDEN_LO(a), WIDEN_LO(b)), _mm_add_epi32(WIDEN_LO(c), WIDEN_LO(d)));
+	__m128i hi = _mm_add_epi32(_mm_add_epi32(WIDEN_HI(a), WIDEN_HI(b)), _mm_add_epi32(WIDEN_HI(c), WIDEN_HI(d)));
+#undef WIDEN_LO
+#undef WIDEN_HI
+	return _mm_packs_epi32(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+}
+
+/**
+ * SSE2 motion compensation, one block row per iteration.
+ * Produces exactly the same output as IVI_MC_TEMPLATE.
+ */
+template<int size, bool add>
+static void iviMcSSE2(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	const int16 *wptr;
+
+	switch (mcType) {
+	case 0: // fullpel (no interpolation)
+		for (int i = 0; i < size; i++, buf += dpitch, refBuf += pitch)
+			mcWriteRow<size, add>(buf, mcLoadRow<size>(refBuf));
+		break;
+	case 1: // horizontal halfpel interpolation
+		for (int i = 0; i < size; i++, buf += dpitch, refBuf += pitch)
+			mcWriteRow<size, add>(buf, mcHalfpel2(mcLoadRow<size>(refBuf), mcLoadRow<size>(refBuf + 1)));
+		break;
+	case 2: // vertical halfpel interpolation
+		wptr = refBuf + pitch;
+		for (int i = 0; i < size; i++, buf += dpitch, wptr += pitch, refBuf += pitch)
+			mcWriteRow<size, add>(buf, mcHalfpel2(mcLoadRow<size>(refBuf), mcLoadRow<size>(wptr)));
+		break;
+	case 3: // vertical and horizontal halfpel interpolation
+		wptr = refBuf + pitch;
+		for (int i = 0; i < size; i++, buf += dpitch, wptr += pitch, refBuf += pitch)
+			mcWriteRow<size, add>(buf, mcHalfpel4(mcLoadRow<size>(refBuf), mcLoadRow<size>(refBuf + 1),
+				mcLoadRow<size>(wptr), mcLoadRow<size>(wptr + 1)));
+		break;
+	default:
+		break;
+	}
+}
+
+template<int size, bool add>
+static void iviMcAvgSSE2(int16 *buf, const int16 *refBuf, const int16 *refBuf2,
+		uint32 pitch, int mcType, int mcType2) {
+	int16 tmp[size * size];
+
+	iviMcSSE2<size, false>(tmp, size, refBuf, pitch, mcType);
+	iviMcSSE2<size, true>(tmp, size, refBuf2, pitch, mcType2);
+	for (int i = 0; i < size; i++, buf += pitch)
+		mcWriteRow<size, add>(buf, _mm_srai_epi16(mcLoadRow<size>(tmp + i * size), 1));
+}
+
+#define IVI_MC_SSE2_TEMPLATE(size, suffix, add) \
+void IndeoDSP::ffIviMc ## size ##x## size ## suffix(int16 *buf, const int16 *refBuf, \
+											 uint32 pitch, int mcType) \
+{ \
+	iviMcSSE2<size, add>(buf, pitch, refBuf, pitch, mcType); \
+} \
+\
+void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
+												 const int16 *refBuf, \
+												 const int16 *refBuf2, \
+												 uint32 pitch, \
+											   int mcType, int mcType2) \
+{ \
+	iviMcAvgSSE2<size, add>(buf, refBuf, refBuf2, pitch, mcType, mcType2); \
+}
+
+IVI_MC_SSE2_TEMPLATE(8, NoDelta, false)
+IVI_MC_SSE2_TEMPLATE(8, Delta,   true)
+IVI_MC_SSE2_TEMPLATE(4, NoDelta, false)
+IVI_MC_SSE2_TEMPLATE(4, Delta,   true)
+
+#else
+
+#define IVI_MC_SCALAR_TEMPLATE(size, suffix) \
+void IndeoDSP::ffIviMc ## size ##x## size ## suffix(int16 *buf, const int16 *refBuf, \
+											 uint32 pitch, int mcType) \
+{ \
+	ffIviMc ## size ##x## size ## suffix ## C(buf, refBuf, pitch, mcType); \
+} \
+\
+void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
+												 const int16 *refBuf, \
+												 const int16 *refBuf2, \
+												 uint32 pitch, \
+											   int mcType, int mcType2) \
+{ \
+	ffIviMcAvg ## size ##x## size ## suffix ## C(buf, refBuf, refBuf2, pitch, mcType, mcType2); \
+}
+
+IVI_MC_SCALAR_TEMPLATE(8, NoDelta)
+IVI_MC_SCALAR_TEMPLATE(8, Delta)
+IVI_MC_SCALAR_TEMPLATE(4, NoDelta)
+IVI_MC_SCALAR_TEMPLATE(4, Delta)
+
+#endif // INDEO_DSP_SSE2
+
 } // End of namespace Indeo
 } // End of namespace Image
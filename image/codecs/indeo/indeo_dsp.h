@@ -328,6 +328,20 @@ public:
 	 *  @param[in]      mcType2		Interpolation type for forward reference
 	 */
 	static void ffIviMcAvg4x4NoDelta(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+
+	/**
+	 *  Scalar versions of the motion compensation functions above, with the
+	 *  same parameters. The functions above use them when the build has no
+	 *  SIMD version.
+	 */
+	static void ffIviMc8x8DeltaC(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc4x4DeltaC(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc8x8NoDeltaC(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMc4x4NoDeltaC(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	static void ffIviMcAvg8x8DeltaC(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg4x4DeltaC(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg8x8NoDeltaC(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+	static void ffIviMcAvg4x4NoDeltaC(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
 };
 
 } // End of namespace Indeo
@@ -0,0 +1,282 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "image/image_cache.h"
+#include "image/image_decoder.h"
+
+#include "common/archive.h"
+#include "common/debug.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "graphics/surface.h"
+
+namespace Image {
+
+ImageCache::ArchiveMemberSource::ArchiveMemberSource(const Common::Archive &archive, const Common::String &archiveName, const Common::String &name) :
+		_archive(&archive), _archiveName(archiveName), _name(name) {
+}
+
+Common::String ImageCache::ArchiveMemberSource::getKey() const {
+	return _archiveName + ":" + _name;
+}
+
+Common::SeekableReadStream *ImageCache::ArchiveMemberSource::createReadStream() const {
+	return _archive->createReadStreamForMember(_name);
+}
+
+ImageCache::Source *ImageCache::ArchiveMemberSource::clone() const {
+	return new ArchiveMemberSource(*this);
+}
+
+ImageCache::ImageCache(uint32 memoryBudget) : _memoryBudget(memoryBudget), _memoryUsed(0), _prefetchedMemoryUsed(0) {
+}
+
+ImageCache::~ImageCache() {
+	clear();
+}
+
+const Graphics::Surface *ImageCache::getImage(const Source &source, DecoderFactory factory, const byte **palette) {
+	Common::String key = source.getKey();
+
+	EntryMap::iterator it = _map.find(key);
+	if (it != _map.end()) {
+		// Move the entry to the front of the LRU list
+		Entry *entry = *it->_value;
+		_lru.erase(it->_value);
+		_lru.push_front(entry);
+		it->_value = _lru.begin();
+
+		if (entry->prefetched) {
+			entry->prefetched = false;
+			_prefetchedMemoryUsed -= entry->size;
+		}
+
+		_stats.hits++;
+		if (palette)
+			*palette = entry->palette;
+		return entry->surface;
+	}
+
+	_stats.misses++;
+
+	Entry *entry = decode(key, source, factory);
+	if (!entry) {
+		if (palette)
+			*palette = nullptr;
+		return nullptr;
+	}
+
+	insert(entry);
+
+	if (palette)
+		*palette = entry->palette;
+	return entry->surface;
+}
+
+bool ImageCache::isCached(const Source &source) const {
+	return _map.contains(source.getKey());
+}
+
+void ImageCache::prefetch(const Source &source, DecoderFactory factory) {
+	Common::String key = source.getKey();
+	if (_map.contains(key))
+		return;
+
+	for (Common::List<PrefetchRequest>::const_iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); ++it) {
+		if (it->key == key)
+			return;
+	}
+
+	PrefetchRequest request;
+	request.key = key;
+	request.source = source.clone();
+	request.factory = factory;
+	_prefetchQueue.push_back(request);
+}
+
+uint ImageCache::processPrefetchQueue(uint32 maxMillis) {
+	uint32 startTime = g_system->getMillis();
+
+	while (!_prefetchQueue.empty() && g_system->getMillis() - startTime < maxMillis) {
+		// Wait for some of the prefetched images to be used when they fill the whole budget
+		if (!canInsertPrefetched())
+			break;
+
+		PrefetchRequest request = _prefetchQueue.front();
+		_prefetchQueue.pop_front();
+
+		if (!_map.contains(request.key)) {
+			Entry *entry = decode(request.key, *request.source, request.factory);
+			if (entry && insertPrefetched(entry))
+				_stats.prefetched++;
+		}
+
+		delete request.source;
+	}
+
+	return _prefetchQueue.size();
+}
+
+void ImageCache::cancelPrefetch() {
+	for (Common::List<PrefetchRequest>::iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); ++it)
+		delete it->source;
+
+	_prefetchQueue.clear();
+}
+
+void ImageCache::clear() {
+	for (EntryList::iterator it = _lru.begin(); it != _lru.end(); ++it)
+		freeEntry(*it);
+
+	_lru.clear();
+	_map.clear();
+	cancelPrefetch();
+	_memoryUsed = 0;
+	_prefetchedMemoryUsed = 0;
+}
+
+void ImageCache::setMemoryBudget(uint32 memoryBudget) {
+	_memoryBudget = memoryBudget;
+	evict(_memoryBudget);
+}
+
+ImageCache::Entry *ImageCache::decode(const Common::String &key, const Source &source, DecoderFactory factory) {
+	Common::SeekableReadStream *stream = source.createReadStream();
+	if (!stream) {
+		warning("ImageCache: Unable to open '%s'", key.c_str());
+		return nullptr;
+	}
+
+	uint32 startTime = g_system->getMillis();
+
+	ImageDecoder *decoder = factory();
+	Entry *entry = nullptr;
+
+	if (decoder->loadStream(*stream) && decoder->getSurface()) {
+		const Graphics::Surface *surface = decoder->getSurface();
+
+		entry = new Entry();
+		entry->key = key;
+		entry->surface = new Graphics::Surface();
+		entry->surface->copyFrom(*surface);
+		entry->size = entry->surface->pitch * entry->surface->h;
+		entry->palette = nullptr;
+		entry->prefetched = false;
+
+		uint16 colorCount = decoder->getPaletteColorCount();
+		if (colorCount) {
+			// Store the palette as a full 256 entry table, the start index is not preserved otherwise
+			uint paletteStart = decoder->getPaletteStartIndex();
+			entry->palette = new byte[256 * 3]();
+			memcpy(entry->palette + paletteStart * 3, decoder->getPalette(), MIN<uint>(colorCount, 256 - paletteStart) * 3);
+			entry->size += 256 * 3;
+		}
+	} else {
+		warning("ImageCache: Unable to decode '%s'", key.c_str());
+	}
+
+	delete decoder;
+	delete stream;
+
+	uint32 decodeTime = g_system->getMillis() - startTime;
+	_stats.decodeTime += decodeTime;
+	debug(5, "ImageCache: Decoded '%s' in %d ms", key.c_str(), decodeTime);
+
+	return entry;
+}
+
+void ImageCache::insert(Entry *entry) {
+	// Make room for the new entry first, so it is never evicted right away
+	if (entry->size <= _memoryBudget)
+		evict(_memoryBudget - entry->size);
+	else
+		evict(0);
+
+	_lru.push_front(entry);
+	_map[entry->key] = _lru.begin();
+	_memoryUsed += entry->size;
+}
+
+bool ImageCache::canInsertPrefetched() const {
+	// Only the images which are not waiting to be used can make room for a prefetched one
+	return _memoryUsed < _memoryBudget || _memoryUsed > _prefetchedMemoryUsed;
+}
+
+bool ImageCache::insertPrefetched(Entry *entry) {
+	uint32 evictableMemory = _memoryUsed - _prefetchedMemoryUsed;
+	uint32 freeMemory = _memoryUsed < _memoryBudget ? _memoryBudget - _memoryUsed : 0;
+
+	if (entry->size > freeMemory + evictableMemory) {
+		_stats.prefetchDropped++;
+		freeEntry(entry);
+		return false;
+	}
+
+	// The unused prefetched images are at the end of the LRU list, behind the
+	// images in use. Evict the least recently used image in use instead of them.
+	EntryList::iterator it = _lru.end();
+	while (_memoryUsed + entry->size > _memoryBudget) {
+		--it;
+		if ((*it)->prefetched)
+			continue;
+
+		EntryList::iterator victim = it++;
+		removeEntry(victim);
+		_stats.evictions++;
+	}
+
+	// Prefetched images stay behind the images in use, so they are the
+	// first to go when an image in use needs room
+	entry->prefetched = true;
+	_lru.push_back(entry);
+	_map[entry->key] = --_lru.end();
+	_memoryUsed += entry->size;
+	_prefetchedMemoryUsed += entry->size;
+	return true;
+}
+
+void ImageCache::evict(uint32 memoryBudget) {
+	while (_memoryUsed > memoryBudget && !_lru.empty()) {
+		removeEntry(--_lru.end());
+		_stats.evictions++;
+	}
+}
+
+void ImageCache::removeEntry(EntryList::iterator it) {
+	Entry *entry = *it;
+	_lru.erase(it);
+	_map.erase(entry->key);
+
+	_memoryUsed -= entry->size;
+	if (entry->prefetched)
+		_prefetchedMemoryUsed -= entry->size;
+	freeEntry(entry);
+}
+
+void ImageCache::freeEntry(Entry *entry) {
+	entry->surface->free();
+	delete entry->surface;
+	delete[] entry->palette;
+	delete entry;
+}
+
+} // End of namespace Image
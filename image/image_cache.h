@@ -0,0 +1,226 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef IMAGE_IMAGE_CACHE_H
+#define IMAGE_IMAGE_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/list.h"
+#include "common/str.h"
+
+namespace Common {
+class Archive;
+class SeekableReadStream;
+}
+
+namespace Graphics {
+struct Surface;
+}
+
+namespace Image {
+
+class ImageDecoder;
+
+/**
+ * @defgroup image_cache Decoded image cache
+ * @ingroup image
+ *
+ * @brief Memory-budgeted cache of decoded images.
+ * @{
+ */
+
+/**
+ * A cache of decoded images, keyed by the identity of the archive member
+ * they were decoded from.
+ *
+ * Images are evicted in least recently used order once the total size
+ * of the cached surfaces and palettes exceeds the memory budget.
+ *
+ * Images can be queued for prefetching, for example when the next scene
+ * is known in advance. The queue is decoded by processPrefetchQueue(),
+ * which the engine calls when it has time to spare, e.g. once per frame.
+ * Prefetched images are kept behind the images in use, and prefetching
+ * never evicts another prefetched image which has not been used yet.
+ */
+class ImageCache {
+public:
+	/** Create the decoder used for an image. */
+	typedef ImageDecoder *(*DecoderFactory)();
+
+	/**
+	 * The location an image is decoded from.
+	 */
+	class Source {
+	public:
+		virtual ~Source() {}
+
+		/**
+		 * Return the identity of the image, used as the cache key.
+		 *
+		 * The key must be unique to the image and stay the same when
+		 * the container of the image is closed and opened again, for
+		 * example the file name of an archive followed by the member name.
+		 */
+		virtual Common::String getKey() const = 0;
+
+		/** Open the stream containing the encoded image. */
+		virtual Common::SeekableReadStream *createReadStream() const = 0;
+
+		/** Create a copy of this source, kept in the prefetch queue. */
+		virtual Source *clone() const = 0;
+	};
+
+	/**
+	 * An image stored as a member of a Common::Archive.
+	 */
+	class ArchiveMemberSource : public Source {
+	public:
+		/**
+		 * @param archive      The archive containing the image.
+		 * @param archiveName  A name identifying the archive, such as its file name.
+		 *                     The address of the archive object cannot be used, it
+		 *                     may be reused by another archive once this one is gone.
+		 * @param name         The name of the member in the archive.
+		 */
+		ArchiveMemberSource(const Common::Archive &archive, const Common::String &archiveName, const Common::String &name);
+
+		Common::String getKey() const override;
+		Common::SeekableReadStream *createReadStream() const override;
+		Source *clone() const override;
+
+	private:
+		const Common::Archive *_archive;
+		Common::String _archiveName;
+		Common::String _name;
+	};
+
+	/** Cache usage statistics. */
+	struct Stats {
+		uint32 hits;        ///< Lookups served from the cache
+		uint32 misses;      ///< Lookups that had to decode the image
+		uint32 prefetched;  ///< Images decoded from the prefetch queue
+		uint32 prefetchDropped; ///< Prefetched images dropped for lack of memory
+		uint32 evictions;   ///< Images dropped to respect the memory budget
+		uint32 decodeTime;  ///< Total time spent decoding, in milliseconds
+
+		Stats() : hits(0), misses(0), prefetched(0), prefetchDropped(0), evictions(0), decodeTime(0) {}
+	};
+
+	/**
+	 * @param memoryBudget  Maximum amount of memory used by cached images, in bytes.
+	 */
+	ImageCache(uint32 memoryBudget);
+	~ImageCache();
+
+	/**
+	 * Return the decoded image for a source, decoding it if necessary.
+	 *
+	 * The returned surface is owned by the cache. It stays valid until the next
+	 * call which may add an image to the cache (getImage, processPrefetchQueue)
+	 * or remove one (clear, setMemoryBudget).
+	 *
+	 * @param source   The location of the image.
+	 * @param factory  Creates the decoder used for this image type.
+	 * @param palette  If not nullptr, receives the palette of the image (or nullptr).
+	 * @return The decoded surface, or nullptr if the image could not be loaded.
+	 */
+	const Graphics::Surface *getImage(const Source &source, DecoderFactory factory, const byte **palette = nullptr);
+
+	/** Check whether an image is currently cached. */
+	bool isCached(const Source &source) const;
+
+	/**
+	 * Queue an image to be decoded by processPrefetchQueue().
+	 * Already cached or already queued images are ignored.
+	 *
+	 * The containers of the queued images must stay open until the queue
+	 * has been processed or cancelled.
+	 */
+	void prefetch(const Source &source, DecoderFactory factory);
+
+	/**
+	 * Decode queued images until the queue is empty or the time budget is exhausted.
+	 * Nothing is decoded when the budget is zero.
+	 *
+	 * @param maxMillis  Time budget for this call, in milliseconds.
+	 * @return The number of images still queued.
+	 */
+	uint processPrefetchQueue(uint32 maxMillis);
+
+	/** Drop all queued prefetch requests. */
+	void cancelPrefetch();
+
+	/** Drop all cached images and queued prefetch requests. */
+	void clear();
+
+	/** Change the memory budget, evicting images if necessary. */
+	void setMemoryBudget(uint32 memoryBudget);
+	uint32 getMemoryBudget() const { return _memoryBudget; }
+
+	/** Return the amount of memory currently used by cached images, in bytes. */
+	uint32 getMemoryUsed() const { return _memoryUsed; }
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats() { _stats = Stats(); }
+
+private:
+	struct Entry {
+		Common::String key;
+		Graphics::Surface *surface;
+		byte *palette;
+		uint32 size;
+		bool prefetched; ///< Decoded ahead of time and not used yet
+	};
+
+	struct PrefetchRequest {
+		Common::String key;
+		Source *source;
+		DecoderFactory factory;
+	};
+
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Common::String, EntryList::iterator> EntryMap;
+
+	Entry *decode(const Common::String &key, const Source &source, DecoderFactory factory);
+	bool canInsertPrefetched() const;
+	void insert(Entry *entry);
+	bool insertPrefetched(Entry *entry);
+	void evict(uint32 memoryBudget);
+	void removeEntry(EntryList::iterator it);
+	void freeEntry(Entry *entry);
+
+	/** Cached images, most recently used first, followed by the unused prefetched ones. */
+	EntryList _lru;
+	EntryMap _map;
+	Common::List<PrefetchRequest> _prefetchQueue;
+
+	uint32 _memoryBudget;
+	uint32 _memoryUsed;
+	uint32 _prefetchedMemoryUsed;
+	Stats _stats;
+};
+
+/** @} */
+} // End of namespace Image
+
+#endif
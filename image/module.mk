@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	bmp.o \
 	cel_3do.o \
 	iff.o \
+	image_cache.o \
 	jpeg.o \
 	pcx.o \
 	pict.o \
@@ -0,0 +1,364 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/pixelformat.h"
+#include "graphics/tinygl/zgl.h"
+
+class TinyGLTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 160,
+		kHeight = 200
+	};
+
+	/**
+	 * Render a few overlapping, partially transparent triangles
+	 * and return a copy of the color and depth buffers.
+	 */
+	void render(bool dirtyRects, byte *pixels, unsigned int *depth) {
+		Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		TinyGL::FrameBuffer *fb = new TinyGL::FrameBuffer(kWidth, kHeight, format);
+		TinyGL::glInit(fb, 256);
+		tglEnableDirtyRects(dirtyRects);
+
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		tglClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglEnable(TGL_DEPTH_TEST);
+		tglShadeModel(TGL_SMOOTH);
+
+		// Simple LCG so that the scene doesn't depend on the random source
+		uint32 seed = 0x1234;
+		for (int i = 0; i < 24; i++) {
+			if (i == 12) {
+				tglEnable(TGL_BLEND);
+				tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+			}
+
+			tglBegin(TGL_TRIANGLES);
+			for (int j = 0; j < 3; j++) {
+				float v[7];
+				for (int k = 0; k < 7; k++) {
+					seed = seed * 1103515245 + 12345;
+					v[k] = ((seed >> 16) & 0x7fff) / 32767.0f;
+				}
+				tglColor4f(v[3], v[4], v[5], v[6]);
+				tglVertex3f(v[0] * 2.4f - 1.2f, v[1] * 2.4f - 1.2f, v[2] * 2.0f - 1.0f);
+			}
+			tglEnd();
+		}
+
+		TinyGL::tglPresentBuffer();
+
+		memcpy(pixels, fb->getPixelBuffer(), kWidth * kHeight * 4);
+		memcpy(depth, fb->getZBuffer(), kWidth * kHeight * sizeof(unsigned int));
+
+		TinyGL::glClose();
+		delete fb;
+	}
+
+	enum DrawMode {
+		kDrawImmediate,
+		kDrawArrays,
+		kDrawElements
+	};
+
+	/**
+	 * Render a textured, vertex colored triangle strip either in immediate
+	 * mode or from client side arrays and return a copy of the color buffer.
+	 * The vertices are stored in reverse order, indexed draws use them front to back.
+	 */
+	void renderArrays(DrawMode mode, bool indexed, byte *pixels) {
+		Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		TinyGL::FrameBuffer *fb = new TinyGL::FrameBuffer(kWidth, kHeight, format);
+		TinyGL::glInit(fb, 256);
+		tglEnableDirtyRects(false);
+
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglFrustum(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 10.0f);
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+		tglTranslatef(0.1f, -0.2f, -2.5f);
+		tglRotatef(30.0f, 0.3f, 1.0f, 0.2f);
+
+		byte texels[8 * 8 * 4];
+		for (int i = 0; i < 8 * 8; i++) {
+			byte value = ((i & 1) ^ ((i >> 3) & 1)) ? 255 : 64;
+			texels[i * 4 + 0] = value;
+			texels[i * 4 + 1] = 255 - value;
+			texels[i * 4 + 2] = value;
+			texels[i * 4 + 3] = 255;
+		}
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, 8, 8, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, texels);
+		tglEnable(TGL_TEXTURE_2D);
+
+		tglClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglEnable(TGL_DEPTH_TEST);
+		tglShadeModel(TGL_SMOOTH);
+
+		// A strip of 12 vertices
+		enum { kVertexCount = 12 };
+		float vertices[kVertexCount * 3], colors[kVertexCount * 4], texCoords[kVertexCount * 2];
+		uint16 indices[kVertexCount];
+		for (int i = 0; i < kVertexCount; i++) {
+			int slot = kVertexCount - 1 - i;
+			indices[i] = slot;
+			vertices[slot * 3 + 0] = (i / 2) * 0.4f - 1.0f;
+			vertices[slot * 3 + 1] = (i & 1) ? 0.8f : -0.8f;
+			vertices[slot * 3 + 2] = (i % 3) * 0.3f;
+			colors[slot * 4 + 0] = (i % 4) / 3.0f;
+			colors[slot * 4 + 1] = 1.0f - (i % 5) / 4.0f;
+			colors[slot * 4 + 2] = 0.5f;
+			colors[slot * 4 + 3] = 1.0f;
+			texCoords[slot * 2 + 0] = (i / 2) * 0.5f;
+			texCoords[slot * 2 + 1] = (i & 1) ? 2.0f : 0.0f;
+		}
+
+		if (mode == kDrawImmediate) {
+			tglBegin(TGL_TRIANGLE_STRIP);
+			for (int i = 0; i < kVertexCount; i++) {
+				int slot = indexed ? indices[i] : i;
+				tglColor4f(colors[slot * 4], colors[slot * 4 + 1], colors[slot * 4 + 2], colors[slot * 4 + 3]);
+				tglTexCoord2f(texCoords[slot * 2], texCoords[slot * 2 + 1]);
+				tglVertex3f(vertices[slot * 3], vertices[slot * 3 + 1], vertices[slot * 3 + 2]);
+			}
+			tglEnd();
+		} else {
+			tglEnableClientState(TGL_VERTEX_ARRAY);
+			tglEnableClientState(TGL_COLOR_ARRAY);
+			tglEnableClientState(TGL_TEXTURE_COORD_ARRAY);
+			tglVertexPointer(3, TGL_FLOAT, 0, vertices);
+			tglColorPointer(4, TGL_FLOAT, 0, colors);
+			tglTexCoordPointer(2, TGL_FLOAT, 0, texCoords);
+			if (mode == kDrawArrays) {
+				tglDrawArrays(TGL_TRIANGLE_STRIP, 0, kVertexCount);
+			} else {
+				tglDrawElements(TGL_TRIANGLE_STRIP, kVertexCount, TGL_UNSIGNED_SHORT, indices);
+			}
+			tglDisableClientState(TGL_VERTEX_ARRAY);
+			tglDisableClientState(TGL_COLOR_ARRAY);
+			tglDisableClientState(TGL_TEXTURE_COORD_ARRAY);
+		}
+
+		TinyGL::tglPresentBuffer();
+
+		memcpy(pixels, fb->getPixelBuffer(), kWidth * kHeight * 4);
+
+		tglDeleteTextures(1, &texture);
+		TinyGL::glClose();
+		delete fb;
+	}
+
+	void drawQuad(float x, float y, float size, float r, float g, float b) {
+		tglColor4f(r, g, b, 1.0f);
+		tglBegin(TGL_QUADS);
+		tglVertex3f(x, y, 0.0f);
+		tglVertex3f(x + size, y, 0.0f);
+		tglVertex3f(x + size, y + size, 0.0f);
+		tglVertex3f(x, y + size, 0.0f);
+		tglEnd();
+	}
+
+	/**
+	 * Draw two frames of three quads, the first two are swapped in the second
+	 * frame and the third one moves. Return a copy of the second frame.
+	 */
+	void renderReorderedFrames(bool dirtyRects, byte *pixels, int *redrawnPixels, int *reusedDrawCalls) {
+		Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		TinyGL::FrameBuffer *fb = new TinyGL::FrameBuffer(kWidth, kHeight, format);
+		TinyGL::glInit(fb, 256);
+		tglEnableDirtyRects(dirtyRects);
+
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+		tglClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+		for (int frame = 0; frame < 2; frame++) {
+			tglClear(TGL_COLOR_BUFFER_BIT);
+			if (frame == 0) {
+				drawQuad(-0.9f, -0.9f, 0.5f, 1.0f, 0.0f, 0.0f);
+				drawQuad(0.3f, 0.3f, 0.5f, 0.0f, 1.0f, 0.0f);
+				drawQuad(-0.2f, 0.0f, 0.2f, 0.0f, 0.0f, 1.0f);
+			} else {
+				drawQuad(0.3f, 0.3f, 0.5f, 0.0f, 1.0f, 0.0f);
+				drawQuad(-0.9f, -0.9f, 0.5f, 1.0f, 0.0f, 0.0f);
+				drawQuad(-0.1f, 0.0f, 0.2f, 0.0f, 0.0f, 1.0f);
+			}
+			TinyGL::tglPresentBuffer();
+		}
+
+		memcpy(pixels, fb->getPixelBuffer(), kWidth * kHeight * 4);
+
+		int totalPixels, totalDrawCalls;
+		tglGetDirtyRectStats(redrawnPixels, &totalPixels, reusedDrawCalls, &totalDrawCalls);
+		TS_ASSERT_EQUALS(totalPixels, kWidth * kHeight);
+		TS_ASSERT_EQUALS(totalDrawCalls, 4);
+
+		TinyGL::glClose();
+		delete fb;
+	}
+
+	/**
+	 * Draw a 64x64 checkerboard texture of single texel squares on an 8x8 pixels quad
+	 * and return the average distance of the pixels to mid gray. With generateMipmap,
+	 * the texture is uploaded without mipmaps and they are built by tglGenerateMipmap.
+	 */
+	int renderMinifiedChecker(int minFilter, bool generateMipmap, unsigned int *uploadMipmapMemoryUsed, unsigned int *memoryUsed, unsigned int *mipmapMemoryUsed) {
+		Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		TinyGL::FrameBuffer *fb = new TinyGL::FrameBuffer(kWidth, kHeight, format);
+		TinyGL::glInit(fb, 256);
+		tglEnableDirtyRects(false);
+
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		byte *texels = new byte[64 * 64 * 4];
+		for (int y = 0; y < 64; y++) {
+			for (int x = 0; x < 64; x++) {
+				byte value = ((x ^ y) & 1) ? 255 : 0;
+				memset(texels + (y * 64 + x) * 4, value, 4);
+			}
+		}
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, generateMipmap ? TGL_NEAREST : minFilter);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MAG_FILTER, TGL_NEAREST);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, 64, 64, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, texels);
+		if (generateMipmap) {
+			tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, minFilter);
+			tglGenerateMipmap(TGL_TEXTURE_2D);
+		}
+		tglEnable(TGL_TEXTURE_2D);
+		delete[] texels;
+
+		tglGetTextureMemoryStats(memoryUsed, uploadMipmapMemoryUsed);
+
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+		const float size = 8.0f * 2.0f / kWidth;
+		tglBegin(TGL_QUADS);
+		tglTexCoord2f(0.0f, 0.0f);
+		tglVertex3f(0.0f, 0.0f, 0.0f);
+		tglTexCoord2f(1.0f, 0.0f);
+		tglVertex3f(size, 0.0f, 0.0f);
+		tglTexCoord2f(1.0f, 1.0f);
+		tglVertex3f(size, size * kWidth / kHeight, 0.0f);
+		tglTexCoord2f(0.0f, 1.0f);
+		tglVertex3f(0.0f, size * kWidth / kHeight, 0.0f);
+		tglEnd();
+		TinyGL::tglPresentBuffer();
+
+		tglGetTextureMemoryStats(memoryUsed, mipmapMemoryUsed);
+
+		// Sample the inside of the quad
+		int distance = 0;
+		const uint32 *pixels = (const uint32 *)fb->getPixelBuffer();
+		for (int y = kHeight / 2 - 6; y < kHeight / 2 - 2; y++) {
+			for (int x = kWidth / 2 + 2; x < kWidth / 2 + 6; x++) {
+				distance += ABS((int)((pixels[y * kWidth + x] >> 8) & 0xff) - 128);
+			}
+		}
+
+		tglDeleteTextures(1, &texture);
+		TinyGL::glClose();
+		delete fb;
+		return distance / 16;
+	}
+
+public:
+	void test_mipmaps() {
+		unsigned int uploadMipmapMemoryUsed, memoryUsed, mipmapMemoryUsed;
+
+		// Without mipmaps, single texels are picked from the checkerboard
+		int distance = renderMinifiedChecker(TGL_NEAREST, false, &uploadMipmapMemoryUsed, &memoryUsed, &mipmapMemoryUsed);
+		TS_ASSERT_LESS_THAN(100, distance);
+		TS_ASSERT_EQUALS(mipmapMemoryUsed, 0u);
+
+		// The mipmap level matching the quad's size is uniformly gray. The
+		// mipmaps are generated on upload, not while drawing.
+		distance = renderMinifiedChecker(TGL_NEAREST_MIPMAP_NEAREST, false, &uploadMipmapMemoryUsed, &memoryUsed, &mipmapMemoryUsed);
+		TS_ASSERT_LESS_THAN(distance, 4);
+		TS_ASSERT_LESS_THAN(0u, uploadMipmapMemoryUsed);
+		TS_ASSERT_EQUALS(mipmapMemoryUsed, uploadMipmapMemoryUsed);
+		TS_ASSERT_EQUALS(memoryUsed, 64u * 64u * 4u + mipmapMemoryUsed);
+
+		distance = renderMinifiedChecker(TGL_NEAREST_MIPMAP_NEAREST, true, &uploadMipmapMemoryUsed, &memoryUsed, &mipmapMemoryUsed);
+		TS_ASSERT_LESS_THAN(distance, 4);
+		TS_ASSERT_LESS_THAN(0u, uploadMipmapMemoryUsed);
+		TS_ASSERT_EQUALS(mipmapMemoryUsed, uploadMipmapMemoryUsed);
+	}
+
+	void test_dirty_rects_reordered() {
+		byte *pixels = new byte[kWidth * kHeight * 4];
+		byte *dirtyPixels = new byte[kWidth * kHeight * 4];
+		int redrawnPixels, reusedDrawCalls;
+
+		renderReorderedFrames(false, pixels, &redrawnPixels, &reusedDrawCalls);
+		TS_ASSERT_EQUALS(redrawnPixels, kWidth * kHeight);
+
+		renderReorderedFrames(true, dirtyPixels, &redrawnPixels, &reusedDrawCalls);
+		TS_ASSERT_EQUALS(memcmp(pixels, dirtyPixels, kWidth * kHeight * 4), 0);
+		// Only the region of the moving quad is redrawn
+		TS_ASSERT_EQUALS(reusedDrawCalls, 3);
+		TS_ASSERT_LESS_THAN(redrawnPixels, kWidth * kHeight / 8);
+
+		delete[] pixels;
+		delete[] dirtyPixels;
+	}
+
+	void test_vertex_arrays() {
+		byte *pixels = new byte[kWidth * kHeight * 4];
+		byte *arrayPixels = new byte[kWidth * kHeight * 4];
+
+		renderArrays(kDrawImmediate, false, pixels);
+		renderArrays(kDrawArrays, false, arrayPixels);
+		TS_ASSERT_EQUALS(memcmp(pixels, arrayPixels, kWidth * kHeight * 4), 0);
+
+		renderArrays(kDrawImmediate, true, pixels);
+		renderArrays(kDrawElements, true, arrayPixels);
+		TS_ASSERT_EQUALS(memcmp(pixels, arrayPixels, kWidth * kHeight * 4), 0);
+
+		// Something was actually drawn
+		bool drawn = false;
+		for (int i = 0; i < kWidth * kHeight * 4 && !drawn; i += 4)
+			drawn = pixels[i + 1] != 0;
+		TS_ASSERT(drawn);
+
+		delete[] pixels;
+		delete[] arrayPixels;
+	}
+
+	void test_dirty_rects_triangles() {
+		byte *pixels = new byte[kWidth * kHeight * 4];
+		byte *dirtyPixels = new byte[kWidth * kHeight * 4];
+		unsigned int *depth = new unsigned int[kWidth * kHeight];
+		unsigned int *dirtyDepth = new unsigned int[kWidth * kHeight];
+
+		render(false, pixels, depth);
+		render(true, dirtyPixels, dirtyDepth);
+
+		TS_ASSERT_EQUALS(memcmp(pixels, dirtyPixels, kWidth * kHeight * 4), 0);
+		TS_ASSERT_EQUALS(memcmp(depth, dirtyDepth, kWidth * kHeight * sizeof(unsigned int)), 0);
+
+		delete[] pixels;
+		delete[] dirtyPixels;
+		delete[] depth;
+		delete[] dirtyDepth;
+	}
+};
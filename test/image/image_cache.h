@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "graphics/surface.h"
+#include "image/image_cache.h"
+#include "image/image_decoder.h"
+
+#include "test/null_osystem.h"
+
+/**
+ * An archive where every member is a single byte, the first
+ * character of the member's name.
+ */
+class ImageCacheTestArchive : public Common::Archive {
+public:
+	ImageCacheTestArchive() : _opened(0) {}
+
+	bool hasFile(const Common::String &name) const { return !name.empty(); }
+	int listMembers(Common::ArchiveMemberList &list) const { return 0; }
+	const Common::ArchiveMemberPtr getMember(const Common::String &name) const {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+	}
+	Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const {
+		_opened++;
+		return new Common::MemoryReadStream((const byte *)name.c_str(), 1);
+	}
+
+	mutable int _opened;
+};
+
+/**
+ * A decoder producing a 16x16 CLUT8 surface filled with the first byte of the stream.
+ */
+class ImageCacheTestDecoder : public Image::ImageDecoder {
+public:
+	~ImageCacheTestDecoder() { destroy(); }
+
+	bool loadStream(Common::SeekableReadStream &stream) {
+		destroy();
+		_surface.create(16, 16, Graphics::PixelFormat::createFormatCLUT8());
+		_surface.fillRect(Common::Rect(16, 16), stream.readByte());
+		return true;
+	}
+	void destroy() { _surface.free(); }
+	const Graphics::Surface *getSurface() const { return &_surface; }
+
+	static Image::ImageDecoder *create() { return new ImageCacheTestDecoder(); }
+
+private:
+	Graphics::Surface _surface;
+};
+
+typedef Image::ImageCache::ArchiveMemberSource ImageCacheTestSource;
+
+class ImageCacheTestSuite : public CxxTest::TestSuite {
+public:
+	void test_hit_and_miss() {
+		Common::install_null_g_system();
+
+		ImageCacheTestArchive archive;
+		Image::ImageCache cache(16 * 16 * 4);
+
+		const Graphics::Surface *surface = cache.getImage(ImageCacheTestSource(archive, "archive", "a"), ImageCacheTestDecoder::create);
+		TS_ASSERT(surface);
+		TS_ASSERT_EQUALS(*(const byte *)surface->getBasePtr(3, 3), 'a');
+		TS_ASSERT_EQUALS(cache.getMemoryUsed(), 16u * 16u);
+
+		cache.getImage(ImageCacheTestSource(archive, "archive", "a"), ImageCacheTestDecoder::create);
+		TS_ASSERT_EQUALS(archive._opened, 1);
+		TS_ASSERT_EQUALS(cache.getStats().hits, 1u);
+		TS_ASSERT_EQUALS(cache.getStats().misses, 1u);
+
+		// The same member name in another archive is a different image
+		ImageCacheTestArchive otherArchive;
+		cache.getImage(ImageCacheTestSource(otherArchive, "other", "a"), ImageCacheTestDecoder::create);
+		TS_ASSERT_EQUALS(otherArchive._opened, 1);
+
+		// A reopened archive is identified by its name, not its address
+		ImageCacheTestArchive reopenedArchive;
+		cache.getImage(ImageCacheTestSource(reopenedArchive, "archive", "a"), ImageCacheTestDecoder::create);
+		TS_ASSERT_EQUALS(reopenedArchive._opened, 0);
+	}
+
+	void test_lru_eviction() {
+		Common::install_null_g_system();
+
+		ImageCacheTestArchive archive;
+		Image::ImageCache cache(16 * 16 * 3);
+
+		cache.getImage(ImageCacheTestSource(archive, "archive", "a"), ImageCacheTestDecoder::create);
+		cache.getImage(ImageCacheTestSource(archive, "archive", "b"), ImageCacheTestDecoder::create);
+		cache.getImage(ImageCacheTestSource(archive, "archive", "c"), ImageCacheTestDecoder::create);
+		cache.getImage(ImageCacheTestSource(archive, "archive", "a"), ImageCacheTestDecoder::create);
+		cache.getImage(ImageCacheTestSource(archive, "archive", "d"), ImageCacheTestDecoder::create);
+
+		TS_ASSERT(cache.isCached(ImageCacheTestSource(archive, "archive", "a")));
+		TS_ASSERT(!cache.isCached(ImageCacheTestSource(archive, "archive", "b")));
+		TS_ASSERT(cache.isCached(ImageCacheTestSource(archive, "archive", "c")));
+		TS_ASSERT(cache.isCached(ImageCacheTestSource(archive, "archive", "d")));
+		TS_ASSERT_EQUALS(cache.getStats().evictions, 1u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsed(), 16u * 16u * 3u);
+
+		cache.setMemoryBudget(16 * 16);
+		TS_ASSERT(cache.isCached(ImageCacheTestSource(archive, "archive", "d")));
+		TS_ASSERT_EQUALS(cache.getMemoryUsed(), 16u * 16u);
+	}
+
+	void test_prefetch() {
+		Common::install_null_g_system();
+
+		ImageCacheTestArchive archive;
+		Image::ImageCache cache(16 * 16 * 8);
+
+		cache.prefetch(ImageCacheTestSource(archive, "archive", "a"), ImageCacheTestDecoder::create);
+		cache.prefetch(ImageCacheTestSource(archive, "archive", "b"), ImageCacheTestDecoder::create);
+		cache.prefetch(ImageCacheTestSource(archive, "archive", "a"), ImageCacheTestDecoder::create);
+		TS_ASSERT_EQUALS(archive._opened, 0);
+
+		// Without a time budget, nothing is decoded
+		TS_ASSERT_EQUALS(cache.processPrefetchQueue(0), 2u);
+		TS_ASSERT_EQUALS(archive._opened, 0);
+
+		while (cache.processPrefetchQueue(1000))
+			;
+
+		TS_ASSERT_EQUALS(archive._opened, 2);
+		TS_ASSERT_EQUALS(cache.getStats().prefetched, 2u);
+
+		cache.getImage(ImageCacheTestSource(archive, "archive", "b"), ImageCacheTestDecoder::create);
+		TS_ASSERT_EQUALS(archive._opened, 2);
+		TS_ASSERT_EQUALS(cache.getStats().hits, 1u);
+	}
+
+	void test_prefetch_full_budget() {
+		Common::install_null_g_system();
+
+		ImageCacheTestArchive archive;
+		Image::ImageCache cache(16 * 16 * 3);
+
+		cache.getImage(ImageCacheTestSource(archive, "archive", "a"), ImageCacheTestDecoder::create);
+		cache.getImage(ImageCacheTestSource(archive, "archive", "b"), ImageCacheTestDecoder::create);
+
+		cache.prefetch(ImageCacheTestSource(archive, "archive", "c"), ImageCacheTestDecoder::create);
+		cache.prefetch(ImageCacheTestSource(archive, "archive", "d"), ImageCacheTestDecoder::create);
+		cache.prefetch(ImageCacheTestSource(archive, "archive", "e"), ImageCacheTestDecoder::create);
+		cache.prefetch(ImageCacheTestSource(archive, "archive", "f"), ImageCacheTestDecoder::create);
+		TS_ASSERT_EQUALS(cache.processPrefetchQueue(1000), 1u);
+
+		// Prefetching evicts the images in use, never the other prefetched images
+		TS_ASSERT(!cache.isCached(ImageCacheTestSource(archive, "archive", "a")));
+		TS_ASSERT(!cache.isCached(ImageCacheTestSource(archive, "archive", "b")));
+		TS_ASSERT(cache.isCached(ImageCacheTestSource(archive, "archive", "c")));
+		TS_ASSERT(cache.isCached(ImageCacheTestSource(archive, "archive", "d")));
+		TS_ASSERT(cache.isCached(ImageCacheTestSource(archive, "archive", "e")));
+		TS_ASSERT(!cache.isCached(ImageCacheTestSource(archive, "archive", "f")));
+		TS_ASSERT_EQUALS(cache.getStats().prefetched, 3u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsed(), 16u * 16u * 3u);
+
+		// Using a prefetched image lets the queue make progress again
+		cache.getImage(ImageCacheTestSource(archive, "archive", "c"), ImageCacheTestDecoder::create);
+		TS_ASSERT_EQUALS(cache.processPrefetchQueue(1000), 0u);
+		TS_ASSERT(!cache.isCached(ImageCacheTestSource(archive, "archive", "c")));
+		TS_ASSERT(cache.isCached(ImageCacheTestSource(archive, "archive", "f")));
+	}
+};
@@ -0,0 +1,169 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/str.h"
+#include "image/codecs/indeo/indeo_dsp.h"
+
+/**
+ * Checks the Indeo motion compensation routines, which may be
+ * vectorized, against a plain scalar implementation.
+ */
+class IndeoDSPTestSuite : public CxxTest::TestSuite {
+	enum {
+		kPitch = 24,
+		kRefSize = kPitch * 10
+	};
+
+	int16 _ref[kRefSize];
+	int16 _ref2[kRefSize];
+	int16 _buf[kRefSize];
+	int16 _expected[kRefSize];
+	uint32 _seed;
+
+	int16 nextValue(uint32 range) {
+		_seed = _seed * 1103515245 + 12345;
+		return (int16)((int32)((_seed >> 8) % range) - (int32)(range / 2));
+	}
+
+	static int16 interpolate(const int16 *ref, int j, int mcType) {
+		switch (mcType) {
+		case 1:
+			return (ref[j] + ref[j + 1]) >> 1;
+		case 2:
+			return (ref[j] + ref[j + kPitch]) >> 1;
+		case 3:
+			return (ref[j] + ref[j + 1] + ref[j + kPitch] + ref[j + kPitch + 1]) >> 2;
+		default:
+			return ref[j];
+		}
+	}
+
+	static void referenceMc(int16 *buf, const int16 *ref, int size, bool add, int mcType) {
+		for (int i = 0; i < size; i++, buf += kPitch, ref += kPitch) {
+			for (int j = 0; j < size; j++) {
+				if (add)
+					buf[j] += interpolate(ref, j, mcType);
+				else
+					buf[j] = interpolate(ref, j, mcType);
+			}
+		}
+	}
+
+	static void referenceMcAvg(int16 *buf, const int16 *ref, const int16 *ref2, int size, bool add,
+			int mcType, int mcType2) {
+		for (int i = 0; i < size; i++, buf += kPitch, ref += kPitch, ref2 += kPitch) {
+			for (int j = 0; j < size; j++) {
+				int16 tmp = interpolate(ref, j, mcType);
+				tmp += interpolate(ref2, j, mcType2);
+				if (add)
+					buf[j] += tmp >> 1;
+				else
+					buf[j] = tmp >> 1;
+			}
+		}
+	}
+
+	void fill() {
+		for (int i = 0; i < kRefSize; i++) {
+			// Include values near the int16 limits to catch overflow in the halfpel paths
+			_ref[i] = nextValue(0x10000);
+			_ref2[i] = nextValue(0x400);
+			_buf[i] = _expected[i] = nextValue(0x400);
+		}
+	}
+
+	void checkBuffers(int size, int mcType) {
+		for (int i = 0; i < kRefSize; i++) {
+			if (_buf[i] != _expected[i]) {
+				TS_FAIL(Common::String::format("size %d, mcType %d: mismatch at %d (%d != %d)",
+					size, mcType, i, _buf[i], _expected[i]).c_str());
+				return;
+			}
+		}
+	}
+
+public:
+	void test_mc() {
+		_seed = 0x1234;
+
+		for (int iter = 0; iter < 16; iter++) {
+			for (int mcType = 0; mcType < 4; mcType++) {
+				fill();
+				Image::Indeo::IndeoDSP::ffIviMc8x8NoDelta(_buf, _ref, kPitch, mcType);
+				referenceMc(_expected, _ref, 8, false, mcType);
+				checkBuffers(8, mcType);
+
+				fill();
+				Image::Indeo::IndeoDSP::ffIviMc8x8Delta(_buf, _ref, kPitch, mcType);
+				referenceMc(_expected, _ref, 8, true, mcType);
+				checkBuffers(8, mcType);
+
+				fill();
+				Image::Indeo::IndeoDSP::ffIviMc4x4NoDelta(_buf, _ref, kPitch, mcType);
+				referenceMc(_expected, _ref, 4, false, mcType);
+				checkBuffers(4, mcType);
+
+				fill();
+				Image::Indeo::IndeoDSP::ffIviMc4x4Delta(_buf, _ref, kPitch, mcType);
+				referenceMc(_expected, _ref, 4, true, mcType);
+				checkBuffers(4, mcType);
+			}
+		}
+	}
+
+	void test_mc_avg() {
+		_seed = 0x1234;
+
+		for (int iter = 0; iter < 4; iter++) {
+			for (int mcType = 0; mcType < 4; mcType++) {
+				for (int mcType2 = 0; mcType2 < 4; mcType2++) {
+					fill();
+					Image::Indeo::IndeoDSP::ffIviMcAvg8x8NoDelta(_buf, _ref, _ref2, kPitch, mcType, mcType2);
+					referenceMcAvg(_expected, _ref, _ref2, 8, false, mcType, mcType2);
+					checkBuffers(8, mcType);
+
+					fill();
+					Image::Indeo::IndeoDSP::ffIviMcAvg8x8Delta(_buf, _ref, _ref2, kPitch, mcType, mcType2);
+					referenceMcAvg(_expected, _ref, _ref2, 8, true, mcType, mcType2);
+					checkBuffers(8, mcType);
+
+					fill();
+					Image::Indeo::IndeoDSP::ffIviMcAvg4x4NoDelta(_buf, _ref, _ref2, kPitch, mcType, mcType2);
+					referenceMcAvg(_expected, _ref, _ref2, 4, false, mcType, mcType2);
+					checkBuffers(4, mcType);
+
+					fill();
+					Image::Indeo::IndeoDSP::ffIviMcAvg4x4Delta(_buf, _ref, _ref2, kPitch, mcType, mcType2);
+					referenceMcAvg(_expected, _ref, _ref2, 4, true, mcType, mcType2);
+					checkBuffers(4, mcType);
+				}
+			}
+		}
+	}
+
+	void test_mc_scalar_fallback() {
+		using Image::Indeo::IndeoDSP;
+		_seed = 0x5678;
+
+		for (int mcType = 0; mcType < 4; mcType++) {
+			fill();
+			IndeoDSP::ffIviMc8x8Delta(_buf, _ref, kPitch, mcType);
+			IndeoDSP::ffIviMc8x8DeltaC(_expected, _ref, kPitch, mcType);
+			checkBuffers(8, mcType);
+
+			fill();
+			IndeoDSP::ffIviMc4x4NoDelta(_buf, _ref, kPitch, mcType);
+			IndeoDSP::ffIviMc4x4NoDeltaC(_expected, _ref, kPitch, mcType);
+			checkBuffers(4, mcType);
+
+			fill();
+			IndeoDSP::ffIviMcAvg8x8NoDelta(_buf, _ref, _ref2, kPitch, mcType, 3 - mcType);
+			IndeoDSP::ffIviMcAvg8x8NoDeltaC(_expected, _ref, _ref2, kPitch, mcType, 3 - mcType);
+			checkBuffers(8, mcType);
+
+			fill();
+			IndeoDSP::ffIviMcAvg4x4Delta(_buf, _ref, _ref2, kPitch, mcType, 3 - mcType);
+			IndeoDSP::ffIviMcAvg4x4DeltaC(_expected, _ref, _ref2, kPitch, mcType, 3 - mcType);
+			checkBuffers(4, mcType);
+		}
+	}
+};